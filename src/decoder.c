@@ -42,9 +42,10 @@
 
 #define DIGIT(x)  (x - '0')
 
+#define TWO_DIGITS(str) (DIGIT(*(str)) * 10 + DIGIT(*((str) + 1)))
+
 #define TZ_TO_OFFSET(str) ( \
-    ((DIGIT(*(str)) * 10 + DIGIT(*(str + 1))) * 3600) + \
-    ((DIGIT(*(str + 2)) * 10 + DIGIT(*(str + 3))) * 60) )
+    (TWO_DIGITS(str) * 3600) + (TWO_DIGITS((str) + 2) * 60) )
 
 struct wandder_dump_action WANDDER_NOACTION =
     (struct wandder_dump_action) {
@@ -92,25 +93,47 @@ void wandder_reset_decoder(wandder_decoder_t *dec) {
     dec->nextitem = NULL;
 }
 
-wandder_decoder_t *init_wandder_decoder(wandder_decoder_t *dec,
-        uint8_t *source, uint32_t len, bool copy) {
+#define DECODER_HANDLER_ITEMS 10000
+#define SMALL_DECODER_HANDLER_ITEMS 16
+
+static wandder_decoder_t *_init_wandder_decoder(wandder_decoder_t *dec,
+        uint8_t *source, uint32_t len, bool copy,
+        wandder_itemhandler_config_t *config) {
 
     if (dec == NULL) {
         dec = (wandder_decoder_t *)malloc(sizeof(wandder_decoder_t));
+        if (dec == NULL) {
+            fprintf(stderr, "libwandder: unable to allocate a new decoder\n");
+            return NULL;
+        }
         dec->toplevel = NULL;
         dec->current = NULL;
         dec->topptr = NULL;
         dec->nextitem = NULL;
-        dec->item_handler = init_wandder_itemhandler(sizeof(wandder_item_t),
-                10000);
-        dec->foundlist_handler = init_wandder_itemhandler(
-                sizeof(wandder_found_item_t) * 10, 10000);
-        dec->found_handler = init_wandder_itemhandler(
-                sizeof(wandder_found_t), 10000);
+        dec->item_handler = init_wandder_itemhandler_config(
+                sizeof(wandder_item_t), config);
+        dec->foundlist_handler = init_wandder_itemhandler_config(
+                sizeof(wandder_found_item_t) * 10, config);
+        dec->found_handler = init_wandder_itemhandler_config(
+                sizeof(wandder_found_t), config);
+
+        if (!dec->item_handler || !dec->foundlist_handler ||
+                !dec->found_handler) {
+            fprintf(stderr, "libwandder: unable to create item pools for a new decoder\n");
+            if (dec->item_handler) {
+                destroy_wandder_itemhandler(dec->item_handler);
+            }
+            if (dec->foundlist_handler) {
+                destroy_wandder_itemhandler(dec->foundlist_handler);
+            }
+            if (dec->found_handler) {
+                destroy_wandder_itemhandler(dec->found_handler);
+            }
+            free(dec);
+            return NULL;
+        }
 
         dec->cacheditems = NULL;
-        dec->cachedts = 0;
-        memset(dec->prevgts, 0, 16);
         dec->source = NULL;
         dec->sourcelen = 0;
     }
@@ -131,6 +154,47 @@ wandder_decoder_t *init_wandder_decoder(wandder_decoder_t *dec,
     return dec;
 }
 
+wandder_decoder_t *init_wandder_decoder(wandder_decoder_t *dec,
+        uint8_t *source, uint32_t len, bool copy) {
+
+    wandder_itemhandler_config_t config;
+
+    wandder_itemhandler_default_config(&config, DECODER_HANDLER_ITEMS,
+            DECODER_HANDLER_ITEMS);
+    return _init_wandder_decoder(dec, source, len, copy, &config);
+}
+
+/* Same as init_wandder_decoder(), except that a newly created decoder
+ * starts with very small item pools that only grow if the decoder
+ * actually needs them. Much cheaper for short-lived decoders, or for
+ * applications that keep large numbers of decoders around.
+ */
+wandder_decoder_t *init_wandder_decoder_small(wandder_decoder_t *dec,
+        uint8_t *source, uint32_t len, bool copy) {
+
+    wandder_itemhandler_config_t config;
+
+    wandder_itemhandler_default_config(&config, SMALL_DECODER_HANDLER_ITEMS,
+            DECODER_HANDLER_ITEMS);
+    return _init_wandder_decoder(dec, source, len, copy, &config);
+}
+
+/* Same as init_wandder_decoder(), except that the item pools of a newly
+ * created decoder are set up using 'config' (see
+ * wandder_itemhandler_default_config()). The config is applied to each of
+ * the decoder's pools separately, so a memory cap limits each pool rather
+ * than the decoder as a whole. Once a pool reaches its cap, decoding and
+ * searching will fail with an error rather than allocating more memory.
+ *
+ * 'config' is ignored if 'dec' is an existing decoder.
+ */
+wandder_decoder_t *init_wandder_decoder_config(wandder_decoder_t *dec,
+        uint8_t *source, uint32_t len, bool copy,
+        wandder_itemhandler_config_t *config) {
+
+    return _init_wandder_decoder(dec, source, len, copy, config);
+}
+
 void free_wandder_decoder(wandder_decoder_t *dec) {
 
     free_cached_items(dec->cacheditems, dec->item_handler);
@@ -158,6 +222,9 @@ static inline wandder_item_t *create_new_item(wandder_decoder_t *dec) {
     if (dec->item_handler) {
         item = (wandder_item_t *)get_wandder_handled_item(dec->item_handler,
                 &memsrc);
+        if (item == NULL) {
+            return NULL;
+        }
         item->memsrc = memsrc;
         item->handler = dec->item_handler;
     } else {
@@ -268,6 +335,10 @@ static int decode(wandder_decoder_t *dec, uint8_t *ptr, wandder_item_t *parent)
     }
 
     item = create_new_item(dec);
+    if (item == NULL) {
+        fprintf(stderr, "libwandder: decoder item pool is exhausted\n");
+        return -1;
+    }
     if (parent == NULL) {
         item->level = 0;
     } else {
@@ -866,101 +937,141 @@ uint32_t stringify_roid(uint8_t *start, uint32_t length, char *space,
     return oid_to_string(start, length, space, spacerem, 0);
 }
 
-static inline struct timeval asn1ts_to_timeval(wandder_decoder_t *dec,
-        char *gts, int len, const char *fmt, int fmtlen) {
+/* Returns the number of days between 1970-01-01 and the given date in
+ * the (proleptic) Gregorian calendar, i.e. the inverse of what gmtime()
+ * does with the date portion of a timestamp.
+ */
+static inline int64_t days_from_civil(int64_t y, int m, int d) {
+
+    int64_t era;
+    int64_t yoe, doy, doe;
+
+    /* Treat March as the first month so that the leap day is at the
+     * end of the year */
+    y -= (m <= 2);
+    era = (y >= 0 ? y : y - 399) / 400;
+    yoe = y - era * 400;
+    doy = (153 * (m > 2 ? m - 3 : m + 9) + 2) / 5 + d - 1;
+    doe = yoe * 365 + yoe / 4 - yoe / 100 + doy;
+    return era * 146097 + doe - 719468;
+}
+
+/* Parses an ASN.1 time string, i.e. either YYYYmmddHHMMSS (GeneralizedTime)
+ * or YYmmddHHMMSS (UTCTime), followed by optional fractional seconds and a
+ * timezone ('Z', '+hhmm' or '-hhmm'). A time string without a timezone is
+ * treated as UTC.
+ *
+ * We do this ourselves rather than using strptime() and mktime() so that
+ * we don't have to worry about the local timezone at all.
+ */
+static inline struct timeval asn1ts_to_timeval(char *gts, int len,
+        int yearlen) {
 
     struct timeval tv;
-    struct tm tm, localres;
-    char *nxt = NULL;
-    char *skipto = NULL;
-    uint32_t ms = 0;
-    int tzcorrect = 0, gmtoffset = 0;
-    time_t current;
+    int fixedlen = yearlen + 10;
+    int i, year, mon, day, hour, min, sec;
+    int tzoff = 0;
+    int64_t usec = 0, scale = 100000;
+    char *ptr;
+    char *end = gts + len;
 
     tv.tv_sec = 0;
     tv.tv_usec = 0;
 
-    if (len < fmtlen) {
-        fprintf(stderr, "ASN.1 time string %s is too short!\n", gts);
+    if (len < fixedlen) {
+        fprintf(stderr, "ASN.1 time string %.*s is too short!\n", len, gts);
         return tv;
     }
 
-    nxt = gts + fmtlen;     /* YYYYmmddHHMMSS for generalized time */
-
-    if (*nxt == '.') {
-        skipto = nxt + 1;
-
-        while (*skipto) {
-            if (*skipto == 'Z' || *skipto == '+' || *skipto == '-') {
-                break;
-            }
-
-            if (*skipto < '0' || *skipto > '9') {
-                fprintf(stderr, "Unexpected character in time string %s (%c)\n", gts, *skipto);
-                return tv;
-            }
-            ms = ms * 10 + ((*skipto) - '0');
-            skipto ++;
+    for (i = 0; i < fixedlen; i++) {
+        if (gts[i] < '0' || gts[i] > '9') {
+            fprintf(stderr, "Unexpected character in time string %.*s (%c)\n",
+                    len, gts, gts[i]);
+            return tv;
         }
     }
 
-    if (memcmp(gts, dec->prevgts, fmtlen) == 0) {
-        tv.tv_sec = dec->cachedts;
-        tv.tv_usec = ms * 1000;
+    if (yearlen == 4) {
+        year = TWO_DIGITS(gts) * 100 + TWO_DIGITS(gts + 2);
+    } else {
+        /* Same interpretation as strptime's %y */
+        year = TWO_DIGITS(gts);
+        year += (year < 69) ? 2000 : 1900;
+    }
+
+    ptr = gts + yearlen;
+    mon = TWO_DIGITS(ptr);
+    day = TWO_DIGITS(ptr + 2);
+    hour = TWO_DIGITS(ptr + 4);
+    min = TWO_DIGITS(ptr + 6);
+    sec = TWO_DIGITS(ptr + 8);
+
+    if (mon < 1 || mon > 12 || day < 1 || day > 31 || hour > 23 ||
+            min > 59 || sec > 60) {
+        fprintf(stderr, "Invalid date or time in time string %.*s\n",
+                len, gts);
         return tv;
     }
 
-    if (strptime(gts, fmt, &tm) == NULL) {
-        fprintf(stderr, "strptime failed to parse time: %s\n", gts);
-        return tv;
-    }
-    /* The time is going to be interpreted as UTC, so we'll need to
-     * remove any timezone differences using TZ_TO_OFFSET. However, mktime
-     * assumes local time so we'll need to also add the time difference
-     * between us and UTC to get a sensible unix timestamp.
-     *
-     * TODO maybe only do the localtime() call if the TZ is different
-     * to previously?
-     */
-    current = time(NULL);
-    gmtoffset = (localtime_r(&current, &localres))->tm_gmtoff;
-
-    switch(*skipto) {
-        case 'Z':
-            tzcorrect = gmtoffset;
-            break;
-        case '+':
-            tzcorrect = gmtoffset - TZ_TO_OFFSET(skipto + 1);
-            break;
-        case '-':
-            tzcorrect = gmtoffset + TZ_TO_OFFSET(skipto + 1);
-            break;
+    ptr = gts + fixedlen;
+    if (ptr < end && (*ptr == '.' || *ptr == ',')) {
+        ptr ++;
+        while (ptr < end && *ptr >= '0' && *ptr <= '9') {
+            usec += DIGIT(*ptr) * scale;
+            scale /= 10;
+            ptr ++;
+        }
     }
 
-    tm.tm_isdst = -1;       // important! required to do DST calc automatically
-    tm.tm_gmtoff = 0;
-    tv.tv_sec = mktime(&tm) + tzcorrect;
-    tv.tv_usec = ms * 1000;
+    if (ptr < end) {
+        switch(*ptr) {
+            case 'Z':
+            case '\0':
+                break;
+            case '+':
+            case '-':
+                if (end - ptr < 5) {
+                    fprintf(stderr, "Truncated timezone in time string %.*s\n",
+                            len, gts);
+                    return tv;
+                }
+                for (i = 1; i <= 4; i++) {
+                    if (ptr[i] < '0' || ptr[i] > '9') {
+                        fprintf(stderr, "Unexpected character in time string %.*s (%c)\n",
+                                len, gts, ptr[i]);
+                        return tv;
+                    }
+                }
+                tzoff = TZ_TO_OFFSET(ptr + 1);
+                if (*ptr == '-') {
+                    tzoff = -tzoff;
+                }
+                break;
+            default:
+                fprintf(stderr, "Unexpected character in time string %.*s (%c)\n",
+                        len, gts, *ptr);
+                return tv;
+        }
+    }
 
-    dec->cachedts = tv.tv_sec;
-    memcpy(dec->prevgts, gts, fmtlen);
-    dec->prevgts[fmtlen] = '\0';
+    tv.tv_sec = days_from_civil(year, mon, day) * 86400 +
+            hour * 3600 + min * 60 + sec - tzoff;
+    tv.tv_usec = usec;
     return tv;
 }
 
 struct timeval wandder_generalizedts_to_timeval(wandder_decoder_t *dec,
         char *gts, int len) {
 
-    return asn1ts_to_timeval(dec, gts, len, "%Y%m%d%H%M%S", 14);
+    return asn1ts_to_timeval(gts, len, 4);
 }
 
 struct timeval wandder_utcts_to_timeval(wandder_decoder_t *dec,
         char *gts, int len) {
 
-    return asn1ts_to_timeval(dec, gts, len, "%y%m%d%H%M%S", 12);
+    return asn1ts_to_timeval(gts, len, 2);
 }
 
-
 uint32_t stringify_gentime(uint8_t *start, uint32_t length, char *space,
         uint16_t spacerem) {
 
@@ -1064,21 +1175,34 @@ char * wandder_get_valuestr(wandder_item_t *c, char *space, uint16_t len,
     return space;
 }
 
+/* Returns NULL if the decoder's item pools are exhausted. In that case,
+ * an existing 'found' is left untouched.
+ */
 static wandder_found_t *add_found_item(wandder_item_t *item,
         wandder_found_t *found, int targetid, uint16_t type,
         wandder_decoder_t *dec) {
 
     wandder_itemblob_t *fsrc;
+    wandder_item_t *copy;
+    bool created = false;
 
     if (found == NULL) {
         found = (wandder_found_t *)get_wandder_handled_item(dec->found_handler,
                 &fsrc);
+        if (found == NULL) {
+            return NULL;
+        }
 
         found->handler = dec->found_handler;
         found->memsrc = fsrc;
 
         found->list = (wandder_found_item_t *)get_wandder_handled_item(
                 dec->foundlist_handler, &fsrc);
+        if (found->list == NULL) {
+            release_wandder_handled_item(found->handler, found->memsrc);
+            return NULL;
+        }
+        created = true;
         found->list_handler = dec->foundlist_handler;
         found->list_memsrc = fsrc;
         found->itemcount = 0;
@@ -1086,20 +1210,43 @@ static wandder_found_t *add_found_item(wandder_item_t *item,
     }
 
     if (found->itemcount == found->alloced) {
-        found->list = (wandder_found_item_t *)realloc(found->list,
-                sizeof(wandder_found_item_t) * (found->alloced + 10));
         if (found->list_handler) {
+            /* The initial list belongs to the item handler, so it can't
+             * be passed to realloc() */
+            wandder_found_item_t *list;
+
+            list = (wandder_found_item_t *)malloc(
+                    sizeof(wandder_found_item_t) * (found->alloced + 10));
+            if (list == NULL) {
+                assert(0);
+            }
+            memcpy(list, found->list,
+                    sizeof(wandder_found_item_t) * found->itemcount);
             release_wandder_handled_item(found->list_handler,
                     found->list_memsrc);
+            found->list = list;
             found->list_handler = NULL;
             found->list_memsrc = NULL;
+        } else {
+            found->list = (wandder_found_item_t *)realloc(found->list,
+                    sizeof(wandder_found_item_t) * (found->alloced + 10));
+            if (found->list == NULL) {
+                assert(0);
+            }
         }
         found->alloced += 10;
     }
 
-    found->list[found->itemcount].item = (wandder_item_t *)
-            get_wandder_handled_item(dec->item_handler, &fsrc);
+    copy = (wandder_item_t *)get_wandder_handled_item(dec->item_handler,
+            &fsrc);
+    if (copy == NULL) {
+        if (created) {
+            wandder_free_found(found);
+        }
+        return NULL;
+    }
 
+    found->list[found->itemcount].item = copy;
     memcpy(found->list[found->itemcount].item, item, sizeof(wandder_item_t));
     found->list[found->itemcount].targetid = targetid;
     found->list[found->itemcount].interpretas = type;
@@ -1135,12 +1282,13 @@ void wandder_free_found(wandder_found_t *found) {
     }
 }
 
-static inline void check_if_found_ctxt(wandder_decoder_t *dec, uint32_t ident,
+static inline int check_if_found_ctxt(wandder_decoder_t *dec, uint32_t ident,
         wandder_target_t *targets, int targetcount, wandder_found_t **found,
         wandder_dumper_t *actions) {
 
     int i;
     uint16_t interpret;
+    wandder_found_t *added;
 
     for (i = 0; i < targetcount; i++) {
         if (targets[i].found) {
@@ -1160,17 +1308,24 @@ static inline void check_if_found_ctxt(wandder_decoder_t *dec, uint32_t ident,
             interpret = actions->members[ident].interpretas;
         }
 
-        *found = add_found_item(dec->current, *found, i, interpret, dec);
+        added = add_found_item(dec->current, *found, i, interpret, dec);
+        if (added == NULL) {
+            fprintf(stderr, "libwandder: decoder item pool is exhausted\n");
+            return -1;
+        }
+        *found = added;
         targets[i].found = true;
     }
+    return 0;
 }
 
-static inline void check_if_found_noctxt(wandder_decoder_t *dec, uint32_t ident,
+static inline int check_if_found_noctxt(wandder_decoder_t *dec, uint32_t ident,
         wandder_target_t *targets, int targetcount, wandder_found_t **found,
         wandder_dumper_t *actions, uint16_t interpretas) {
 
     int i;
     uint16_t interpret;
+    wandder_found_t *added;
 
     for (i = 0; i < targetcount; i++) {
         if (targets[i].found) {
@@ -1189,9 +1344,15 @@ static inline void check_if_found_noctxt(wandder_decoder_t *dec, uint32_t ident,
         if (ident < actions->membercount && interpret == 0) {
             interpret = actions->members[ident].interpretas;
         }
-        *found = add_found_item(dec->current, *found, i, interpret, dec);
+        added = add_found_item(dec->current, *found, i, interpret, dec);
+        if (added == NULL) {
+            fprintf(stderr, "libwandder: decoder item pool is exhausted\n");
+            return -1;
+        }
+        *found = added;
         targets[i].found = true;
     }
+    return 0;
 }
 
 int wandder_search_items(wandder_decoder_t *dec, uint16_t level,
@@ -1242,13 +1403,17 @@ int wandder_search_items(wandder_decoder_t *dec, uint16_t level,
 
         ident = wandder_get_identifier(dec);
         if (wandder_get_class(dec) == WANDDER_CLASS_CONTEXT_PRIMITIVE) {
-            check_if_found_ctxt(dec, ident, targets, targetcount, found,
-                    actions);
+            if (check_if_found_ctxt(dec, ident, targets, targetcount,
+                        found, actions) < 0) {
+                return -1;
+            }
         }
 
         if (wandder_get_class(dec) == WANDDER_CLASS_CONTEXT_CONSTRUCT) {
-            check_if_found_ctxt(dec, ident, targets, targetcount, found,
-                    actions);
+            if (check_if_found_ctxt(dec, ident, targets, targetcount,
+                        found, actions) < 0) {
+                return -1;
+            }
             if (ident >= actions->membercount) {
                 return 0;
             }
@@ -1268,13 +1433,17 @@ int wandder_search_items(wandder_decoder_t *dec, uint16_t level,
 
         if (wandder_get_class(dec) == WANDDER_CLASS_UNIVERSAL_PRIMITIVE) {
 
-            check_if_found_noctxt(dec, atthislevel, targets, targetcount, found,
-                    actions, ident);
+            if (check_if_found_noctxt(dec, atthislevel, targets,
+                        targetcount, found, actions, ident) < 0) {
+                return -1;
+            }
         }
 
         if (wandder_get_class(dec) == WANDDER_CLASS_UNIVERSAL_CONSTRUCT) {
-            check_if_found_noctxt(dec, atthislevel, targets, targetcount, found,
-                    actions, ident);
+            if (check_if_found_noctxt(dec, atthislevel, targets,
+                        targetcount, found, actions, ident) < 0) {
+                return -1;
+            }
             if (actions->sequence.descend == NULL) {
                 wandder_decode_skip(dec);
                 continue;
@@ -1314,78 +1483,1163 @@ int wandder_search_items(wandder_decoder_t *dec, uint16_t level,
 }
 
 
-int wandder_decode_dump(wandder_decoder_t *dec, uint16_t level,
-        wandder_dumper_t *actions, char *name) {
+#define QUERY_HASH(parent, itemid) \
+    ((uint32_t)((((uintptr_t)(parent)) >> 4) * 2654435761U) ^ \
+     ((itemid) * 40503U))
 
-    char space[2048];
+static inline int query_lookup(wandder_query_t *query,
+        wandder_dumper_t *parent, uint32_t itemid) {
+
+    uint32_t h = QUERY_HASH(parent, itemid) & query->slotmask;
+
+    while (query->slots[h].targetid != -1) {
+        if (query->slots[h].parent == parent &&
+                query->slots[h].itemid == itemid) {
+            return query->slots[h].targetid;
+        }
+        h = (h + 1) & query->slotmask;
+    }
+    return -1;
+}
+
+static inline wandder_query_reach_t *query_reach_slot(
+        wandder_query_reach_t *reach, uint32_t mask,
+        wandder_dumper_t *dumper) {
+
+    uint32_t h = QUERY_HASH(dumper, 0) & mask;
+
+    while (reach[h].dumper != NULL && reach[h].dumper != dumper) {
+        h = (h + 1) & mask;
+    }
+    return &(reach[h]);
+}
+
+static inline int query_can_reach(wandder_query_t *query,
+        wandder_dumper_t *dumper, uint64_t foundmask) {
+
+    wandder_query_reach_t *r;
+
+    r = query_reach_slot(query->reach, query->reachmask, dumper);
+    if (r->dumper == NULL) {
+        /* Not part of the tree we were compiled from, so we can't
+         * rule anything out */
+        return 1;
+    }
+    return ((r->targets & ~foundmask) != 0);
+}
+
+/* Works out which targets can be found beneath each dumper in the tree
+ * rooted at query->root. The dumper "graph" is allowed to contain cycles,
+ * so we just keep propagating target sets upwards until nothing changes.
+ */
+static void compile_query_reachability(wandder_query_t *query,
+        wandder_target_t *targets) {
+
+    wandder_dumper_t **dumpers;
+    wandder_query_reach_t *r, *child;
+    wandder_dumper_t *d, *desc;
+    uint32_t dcount = 0, dalloced = 64, slotcount = 128;
+    uint32_t i, j;
+    int t, changed;
+    uint64_t newmask;
+
+    dumpers = (wandder_dumper_t **)malloc(sizeof(wandder_dumper_t *) *
+            dalloced);
+    query->reach = (wandder_query_reach_t *)calloc(slotcount,
+            sizeof(wandder_query_reach_t));
+    query->reachmask = slotcount - 1;
+
+    r = query_reach_slot(query->reach, query->reachmask, query->root);
+    r->dumper = query->root;
+    dumpers[dcount++] = query->root;
+
+    /* Find every dumper reachable from the root */
+    for (i = 0; i < dcount; i++) {
+        d = dumpers[i];
+        for (j = 0; j <= d->membercount; j++) {
+            if (j == d->membercount) {
+                desc = d->sequence.descend;
+            } else {
+                desc = d->members[j].descend;
+            }
+            if (desc == NULL) {
+                continue;
+            }
+            r = query_reach_slot(query->reach, query->reachmask, desc);
+            if (r->dumper != NULL) {
+                continue;
+            }
+
+            if ((dcount + 1) * 2 > slotcount) {
+                /* Rehash into a bigger table */
+                wandder_query_reach_t *old = query->reach;
+                uint32_t k, oldcount = slotcount;
+
+                slotcount *= 2;
+                query->reach = (wandder_query_reach_t *)calloc(slotcount,
+                        sizeof(wandder_query_reach_t));
+                query->reachmask = slotcount - 1;
+                for (k = 0; k < oldcount; k++) {
+                    if (old[k].dumper) {
+                        *(query_reach_slot(query->reach, query->reachmask,
+                                old[k].dumper)) = old[k];
+                    }
+                }
+                free(old);
+                r = query_reach_slot(query->reach, query->reachmask, desc);
+            }
+
+            r->dumper = desc;
+            if (dcount == dalloced) {
+                dalloced *= 2;
+                dumpers = (wandder_dumper_t **)realloc(dumpers,
+                        sizeof(wandder_dumper_t *) * dalloced);
+            }
+            dumpers[dcount++] = desc;
+        }
+    }
+
+    /* Targets are directly reachable from their parent dumper */
+    for (t = 0; t < query->targetcount; t++) {
+        r = query_reach_slot(query->reach, query->reachmask,
+                targets[t].parent);
+        if (r->dumper != NULL) {
+            r->targets |= (1ULL << t);
+        }
+    }
+
+    do {
+        changed = 0;
+        for (i = 0; i < dcount; i++) {
+            d = dumpers[i];
+            r = query_reach_slot(query->reach, query->reachmask, d);
+            newmask = r->targets;
+            for (j = 0; j <= d->membercount; j++) {
+                if (j == d->membercount) {
+                    desc = d->sequence.descend;
+                } else {
+                    desc = d->members[j].descend;
+                }
+                if (desc == NULL) {
+                    continue;
+                }
+                child = query_reach_slot(query->reach, query->reachmask,
+                        desc);
+                newmask |= child->targets;
+            }
+            if (newmask != r->targets) {
+                r->targets = newmask;
+                changed = 1;
+            }
+        }
+    } while (changed);
+
+    free(dumpers);
+}
+
+wandder_query_t *wandder_compile_query(wandder_dumper_t *root,
+        wandder_target_t *targets, int targetcount) {
+
+    wandder_query_t *query;
+    uint32_t slotcount = 8;
+    uint32_t h;
+    int i, last;
+
+    if (root == NULL) {
+        fprintf(stderr, "libwandder cannot compile a query without a root dumper.\n");
+        return NULL;
+    }
+
+    if (targetcount <= 0 || targetcount > WANDDER_QUERY_MAX_TARGETS) {
+        fprintf(stderr, "libwandder queries must have between 1 and %d targets (not %d).\n",
+                WANDDER_QUERY_MAX_TARGETS, targetcount);
+        return NULL;
+    }
+
+    /* Keep the table no more than half full */
+    while (slotcount < (uint32_t)targetcount * 2) {
+        slotcount *= 2;
+    }
+
+    query = (wandder_query_t *)calloc(1, sizeof(wandder_query_t));
+    query->root = root;
+    query->targetcount = targetcount;
+    query->slotmask = slotcount - 1;
+    query->slots = (wandder_query_slot_t *)calloc(slotcount,
+            sizeof(wandder_query_slot_t));
+    query->nexttarget = (int *)malloc(sizeof(int) * targetcount);
+
+    for (h = 0; h < slotcount; h++) {
+        query->slots[h].targetid = -1;
+    }
+
+    for (i = 0; i < targetcount; i++) {
+        query->nexttarget[i] = -1;
+
+        h = QUERY_HASH(targets[i].parent, targets[i].itemid) &
+                query->slotmask;
+        while (query->slots[h].targetid != -1) {
+            if (query->slots[h].parent == targets[i].parent &&
+                    query->slots[h].itemid == targets[i].itemid) {
+                break;
+            }
+            h = (h + 1) & query->slotmask;
+        }
+
+        if (query->slots[h].targetid == -1) {
+            query->slots[h].parent = targets[i].parent;
+            query->slots[h].itemid = targets[i].itemid;
+            query->slots[h].targetid = i;
+            continue;
+        }
+
+        /* Duplicate key, append to the end of the chain */
+        last = query->slots[h].targetid;
+        while (query->nexttarget[last] != -1) {
+            last = query->nexttarget[last];
+        }
+        query->nexttarget[last] = i;
+    }
+
+    compile_query_reachability(query, targets);
+    return query;
+}
+
+void wandder_free_query(wandder_query_t *query) {
+    if (query == NULL) {
+        return;
+    }
+    free(query->slots);
+    free(query->nexttarget);
+    free(query->reach);
+    free(query);
+}
+
+static inline int check_if_found_query(wandder_decoder_t *dec,
+        uint32_t ident, wandder_query_t *query, uint64_t *foundmask,
+        wandder_found_t **found, wandder_dumper_t *actions,
+        uint16_t interpretas) {
+
+    int t;
+    uint16_t interpret;
+    wandder_found_t *added;
+
+    t = query_lookup(query, actions, ident);
+    for (; t != -1; t = query->nexttarget[t]) {
+        if ((*foundmask) & (1ULL << t)) {
+            continue;
+        }
+
+        interpret = interpretas;
+        if (ident < actions->membercount && interpret == 0) {
+            interpret = actions->members[ident].interpretas;
+        }
+        added = add_found_item(dec->current, *found, t, interpret, dec);
+        if (added == NULL) {
+            fprintf(stderr, "libwandder: decoder item pool is exhausted\n");
+            return -1;
+        }
+        *found = added;
+        (*foundmask) |= (1ULL << t);
+    }
+    return 0;
+}
+
+/* Same walk as wandder_search_items(), except target matching is done
+ * using the compiled query and the found state lives on the stack rather
+ * than in the target array.
+ */
+static int query_search_items(wandder_decoder_t *dec, uint16_t level,
+        wandder_dumper_t *actions, wandder_query_t *query,
+        uint64_t *foundmask, wandder_found_t **found, int stopthresh) {
+
+    struct wandder_dump_action *act;
     int ret;
     uint32_t ident;
-    struct wandder_dump_action *act;
+    uint8_t class;
+    int atthislevel = 0;
 
-    if (dec == NULL) {
-        fprintf(stderr, "libwandder cannot decode using a NULL decoder.\n");
-        return -1;
+    if (*found && (*found)->itemcount == stopthresh) {
+        return stopthresh;
+    }
+
+    if (actions == NULL) {
+        wandder_decode_skip(dec);
+        return 0;
     }
 
     ret = wandder_decode_next(dec);
     if (ret <= 0) {
         return ret;
     }
+
     while (1) {
 
+        if (*found && (*found)->itemcount == stopthresh) {
+            break;
+        }
+
         if (wandder_get_level(dec) < level) {
             break;
         }
 
         ident = wandder_get_identifier(dec);
-        act = &(actions->members[ident]);
-        if (wandder_get_class(dec) == WANDDER_CLASS_CONTEXT_PRIMITIVE) {
+        class = wandder_get_class(dec);
 
-            assert(act->descend == NULL);
-            if (!wandder_get_valuestr(dec->current, space, 2048, act->interpretas)) {
+        if (class == WANDDER_CLASS_CONTEXT_PRIMITIVE) {
+            if (check_if_found_query(dec, ident, query, foundmask, found,
+                        actions, 0) < 0) {
                 return -1;
             }
-
-            printf("[%u] %u %s %s\n", ident, level, act->name, space);
         }
 
-        if (wandder_get_class(dec) == WANDDER_CLASS_CONTEXT_CONSTRUCT) {
-            printf("[%u] %u %s --\n", ident, level, act->name);
+        if (class == WANDDER_CLASS_CONTEXT_CONSTRUCT) {
+            if (check_if_found_query(dec, ident, query, foundmask, found,
+                        actions, 0) < 0) {
+                return -1;
+            }
+            if (ident >= actions->membercount) {
+                return 0;
+            }
 
-            assert(act->descend != NULL);
-            ret = wandder_decode_dump(dec, level + 1, act->descend, act->name);
+            act = &(actions->members[ident]);
+            if (act->descend == NULL) {
+                return 0;
+            }
+            if (!query_can_reach(query, act->descend, *foundmask)) {
+                /* Nothing we are looking for can be in here */
+                wandder_decode_skip(dec);
+                ret = wandder_decode_next(dec);
+                if (ret <= 0) {
+                    break;
+                }
+                continue;
+            }
+            ret = query_search_items(dec, level + 1, act->descend, query,
+                    foundmask, found, stopthresh);
             if (ret <= 0) {
-                return ret;
+                break;
             }
             continue;
         }
 
-        if (wandder_get_class(dec) == WANDDER_CLASS_UNIVERSAL_PRIMITIVE) {
-            if (!wandder_get_valuestr(dec->current, space, 2048, WANDDER_TAG_NULL)) {
+        if (class == WANDDER_CLASS_UNIVERSAL_PRIMITIVE) {
+            if (check_if_found_query(dec, atthislevel, query, foundmask,
+                        found, actions, ident) < 0) {
                 return -1;
             }
-
-            printf("[%u] %u %s %s\n", ident, level, act->name, space);
         }
 
-        if (wandder_get_class(dec) == WANDDER_CLASS_UNIVERSAL_CONSTRUCT) {
-            printf("%u %s --\n", level, actions->sequence.name);
-            ret = wandder_decode_dump(dec, level + 1,
-                    actions->sequence.descend, actions->sequence.name);
+        if (class == WANDDER_CLASS_UNIVERSAL_CONSTRUCT) {
+            if (check_if_found_query(dec, atthislevel, query, foundmask,
+                        found, actions, ident) < 0) {
+                return -1;
+            }
+            if (actions->sequence.descend == NULL ||
+                    !query_can_reach(query, actions->sequence.descend,
+                            *foundmask)) {
+                wandder_decode_skip(dec);
+                ret = wandder_decode_next(dec);
+                if (ret <= 0) {
+                    break;
+                }
+                continue;
+            }
+            ret = query_search_items(dec, level + 1,
+                    actions->sequence.descend, query, foundmask, found,
+                    stopthresh);
 
             if (ret <= 0) {
-                return ret;
+                break;
             }
             continue;
         }
 
+        atthislevel ++;
         ret = wandder_decode_next(dec);
         if (ret <= 0) {
-            return ret;
+            break;
         }
     }
 
+    if (ret <= 0) {
+        return ret;
+    }
     return 1;
 }
 
+/* Searches the message attached to 'dec' for the targets in a compiled
+ * query, starting from the current decoder position (just like
+ * wandder_search_items()). The targetid for each found item is the index
+ * of that target in the array that the query was compiled from.
+ */
+int wandder_execute_query(wandder_decoder_t *dec, wandder_query_t *query,
+        wandder_found_t **found, int stopthresh) {
+
+    uint64_t foundmask = 0;
+    int ret;
+
+    if (dec == NULL) {
+        fprintf(stderr, "libwandder cannot decode using a NULL decoder.\n");
+        return -1;
+    }
+
+    if (query == NULL) {
+        fprintf(stderr, "libwandder cannot execute a NULL query.\n");
+        return -1;
+    }
+
+    if (stopthresh == 0) {
+        stopthresh = query->targetcount;
+    }
+
+    ret = query_search_items(dec, 0, query->root, query, &foundmask, found,
+            stopthresh);
+    if (ret < 0) {
+        return ret;
+    }
+
+    if (*found != NULL) {
+        return (*found)->itemcount;
+    }
+    return 0;
+}
+
+int wandder_decode_dump(wandder_decoder_t *dec, uint16_t level,
+        wandder_dumper_t *actions, char *name) {
+
+    char space[2048];
+    int ret;
+    uint32_t ident;
+    struct wandder_dump_action *act;
+
+    if (dec == NULL) {
+        fprintf(stderr, "libwandder cannot decode using a NULL decoder.\n");
+        return -1;
+    }
+
+    ret = wandder_decode_next(dec);
+    if (ret <= 0) {
+        return ret;
+    }
+    while (1) {
+
+        if (wandder_get_level(dec) < level) {
+            break;
+        }
+
+        ident = wandder_get_identifier(dec);
+        act = &(actions->members[ident]);
+        if (wandder_get_class(dec) == WANDDER_CLASS_CONTEXT_PRIMITIVE) {
+
+            assert(act->descend == NULL);
+            if (!wandder_get_valuestr(dec->current, space, 2048, act->interpretas)) {
+                return -1;
+            }
+
+            printf("[%u] %u %s %s\n", ident, level, act->name, space);
+        }
+
+        if (wandder_get_class(dec) == WANDDER_CLASS_CONTEXT_CONSTRUCT) {
+            printf("[%u] %u %s --\n", ident, level, act->name);
+
+            assert(act->descend != NULL);
+            ret = wandder_decode_dump(dec, level + 1, act->descend, act->name);
+            if (ret <= 0) {
+                return ret;
+            }
+            continue;
+        }
+
+        if (wandder_get_class(dec) == WANDDER_CLASS_UNIVERSAL_PRIMITIVE) {
+            if (!wandder_get_valuestr(dec->current, space, 2048, WANDDER_TAG_NULL)) {
+                return -1;
+            }
+
+            printf("[%u] %u %s %s\n", ident, level, act->name, space);
+        }
+
+        if (wandder_get_class(dec) == WANDDER_CLASS_UNIVERSAL_CONSTRUCT) {
+            printf("%u %s --\n", level, actions->sequence.name);
+            ret = wandder_decode_dump(dec, level + 1,
+                    actions->sequence.descend, actions->sequence.name);
+
+            if (ret <= 0) {
+                return ret;
+            }
+            continue;
+        }
+
+        ret = wandder_decode_next(dec);
+        if (ret <= 0) {
+            return ret;
+        }
+    }
+
+    return 1;
+}
+
+/* Tape decoding
+ * ----------------------------------------------------
+ */
+
+wandder_tape_t *wandder_create_tape(uint32_t initialentries) {
+
+    wandder_tape_t *tape;
+
+    if (initialentries == 0) {
+        initialentries = 256;
+    }
+
+    tape = (wandder_tape_t *)calloc(1, sizeof(wandder_tape_t));
+    tape->entries = (wandder_tape_entry_t *)malloc(initialentries *
+            sizeof(wandder_tape_entry_t));
+    tape->alloced = initialentries;
+    return tape;
+}
+
+void wandder_free_tape(wandder_tape_t *tape) {
+    if (tape == NULL) {
+        return;
+    }
+    free(tape->entries);
+    free(tape);
+}
+
+/* Parses the first complete message in 'source' onto the tape, replacing
+ * whatever was on the tape previously. The tape does not copy the
+ * source, so the buffer must remain valid while the tape is in use.
+ *
+ * Returns the number of bytes in the parsed message, 0 if there was
+ * nothing to parse and -1 if the message is invalid or truncated.
+ */
+int64_t wandder_tape_parse(wandder_tape_t *tape, uint8_t *source,
+        uint32_t len) {
+
+    uint32_t open[WANDDER_TAPE_MAX_DEPTH];
+    int depth = 0;
+    uint8_t *ptr = source;
+    uint8_t *end = source + len;
+    uint8_t *valptr;
+    wandder_tape_entry_t *e, *parent;
+    uint8_t lenoctets;
+    uint64_t longlen;
+    int i;
+
+    if (tape == NULL) {
+        fprintf(stderr, "libwandder cannot parse onto a NULL tape.\n");
+        return -1;
+    }
+
+    tape->count = 0;
+    tape->source = source;
+    tape->sourcelen = 0;
+
+    if (len == 0) {
+        return 0;
+    }
+
+    while (1) {
+        /* Close off any constructed items that end here */
+        while (depth > 0) {
+            parent = &(tape->entries[open[depth - 1]]);
+            valptr = source + parent->offset + parent->preamblelen;
+
+            if (parent->indefform) {
+                if (end - ptr < 2) {
+                    return -1;
+                }
+                if (ptr[0] != 0x00 || ptr[1] != 0x00) {
+                    break;
+                }
+                parent->length = ptr - valptr;
+                ptr += 2;
+            } else if (ptr < valptr + parent->length) {
+                break;
+            } else if (ptr > valptr + parent->length) {
+                /* A child ran past the end of its parent */
+                return -1;
+            }
+            parent->next = tape->count;
+            depth --;
+        }
+
+        if (depth == 0 && tape->count > 0) {
+            break;
+        }
+
+        if (end - ptr < 2) {
+            return -1;
+        }
+
+        if (tape->count == tape->alloced) {
+            tape->alloced *= 2;
+            tape->entries = (wandder_tape_entry_t *)realloc(tape->entries,
+                    tape->alloced * sizeof(wandder_tape_entry_t));
+        }
+
+        e = &(tape->entries[tape->count]);
+        e->offset = ptr - source;
+        e->level = depth;
+        e->identclass = ((*ptr) & 0xe0) >> 5;
+
+        if (((*ptr) & 0x1f) == 0x1f) {
+            ptr ++;
+            e->identifier = 0;
+            i = 0;
+            do {
+                if (ptr >= end || i == 4) {
+                    return -1;
+                }
+                e->identifier = (e->identifier << 7) | ((*ptr) & 0x7f);
+                i ++;
+            } while ((*(ptr++)) & 0x80);
+        } else {
+            e->identifier = (*ptr) & 0x1f;
+            ptr ++;
+        }
+
+        if (ptr >= end) {
+            return -1;
+        }
+
+        e->indefform = 0;
+        if (((*ptr) & 0x80) == 0) {
+            e->length = *ptr;
+            ptr ++;
+        } else if ((lenoctets = ((*ptr) & 0x7f)) == 0) {
+            e->indefform = 1;
+            e->length = 0;
+            ptr ++;
+        } else {
+            if (lenoctets > sizeof(uint64_t) || end - ptr <= lenoctets) {
+                return -1;
+            }
+            ptr ++;
+            longlen = 0;
+            for (i = 0; i < lenoctets; i++) {
+                longlen = (longlen << 8) | (*ptr);
+                ptr ++;
+            }
+            /* Tape offsets are 32 bit, so nothing longer can fit anyway */
+            if (longlen > UINT32_MAX) {
+                return -1;
+            }
+            e->length = (uint32_t)longlen;
+        }
+        e->preamblelen = (ptr - source) - e->offset;
+
+        if (e->indefform && !IS_CONSTRUCTED(e)) {
+            /* Only constructed items may use the indefinite form */
+            return -1;
+        }
+
+        tape->count ++;
+
+        if (IS_CONSTRUCTED(e)) {
+            if (depth == WANDDER_TAPE_MAX_DEPTH) {
+                fprintf(stderr, "libwandder tape cannot handle messages nested more than %d levels deep\n", WANDDER_TAPE_MAX_DEPTH);
+                return -1;
+            }
+            if (!e->indefform && e->length > (uint32_t)(end - ptr)) {
+                return -1;
+            }
+            open[depth] = tape->count - 1;
+            depth ++;
+            continue;
+        }
+
+        if (e->length > (uint32_t)(end - ptr)) {
+            return -1;
+        }
+        ptr += e->length;
+        e->next = tape->count;
+    }
+
+    tape->sourcelen = ptr - source;
+    return tape->sourcelen;
+}
+
+uint8_t *wandder_tape_get_itemptr(wandder_tape_t *tape, uint32_t index) {
+
+    if (index >= tape->count) {
+        return NULL;
+    }
+    return tape->source + tape->entries[index].offset +
+            tape->entries[index].preamblelen;
+}
+
+int64_t wandder_tape_get_integer_value(wandder_tape_t *tape, uint32_t index) {
+
+    uint32_t len;
+
+    if (index >= tape->count) {
+        return 0;
+    }
+    len = tape->entries[index].length;
+    return decode_integer(wandder_tape_get_itemptr(tape, index), &len);
+}
+
+/* Returns the index of the immediate child of 'parent' with the given
+ * identifier, or -1 if there is no such child.
+ */
+int64_t wandder_tape_find_child(wandder_tape_t *tape, uint32_t parent,
+        uint32_t ident) {
+
+    uint32_t i;
+    uint32_t stop;
+
+    if (parent >= tape->count || !IS_CONSTRUCTED((&tape->entries[parent]))) {
+        return -1;
+    }
+
+    stop = tape->entries[parent].next;
+    for (i = parent + 1; i < stop; i = tape->entries[i].next) {
+        if (tape->entries[i].identifier == ident) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+/* Follows a sequence of child identifiers down from 'start', e.g.
+ * {1, 3, 1} from the root of an ETSI PS-PDU will locate the CIN.
+ *
+ * Returns the index of the final item in the path, or -1 if the path
+ * does not exist in the parsed message.
+ */
+int64_t wandder_tape_find_path(wandder_tape_t *tape, uint32_t start,
+        uint32_t *idents, int identcount) {
+
+    int64_t cur = start;
+    int i;
+
+    for (i = 0; i < identcount; i++) {
+        cur = wandder_tape_find_child(tape, (uint32_t)cur, idents[i]);
+        if (cur < 0) {
+            return -1;
+        }
+    }
+    return cur;
+}
+
+/* Framing
+ * ----------------------------------------------------
+ */
+
+/* Works out the total encoded length of the message at the start of 'buf'
+ * by walking only the tag and length fields. Definite length fields are
+ * jumped over in their entirety (regardless of whether they are
+ * constructed), so we only ever need to descend into indefinite length
+ * fields to look for their end-of-contents marker.
+ *
+ * Returns the message length, 0 if 'buf' does not contain the whole
+ * message and -1 if the message is not valid BER.
+ */
+int64_t wandder_get_message_length(uint8_t *buf, uint32_t len) {
+
+    uint8_t *ptr = buf;
+    uint8_t *end = buf + len;
+    uint32_t indefdepth = 0;
+    uint8_t tagbyte, lenoctets;
+    uint64_t vallen;
+    int i;
+
+    do {
+        if (end - ptr < 2) {
+            return 0;
+        }
+
+        if (indefdepth > 0 && ptr[0] == 0x00 && ptr[1] == 0x00) {
+            ptr += 2;
+            indefdepth --;
+            continue;
+        }
+
+        tagbyte = *ptr;
+        ptr ++;
+        if ((tagbyte & 0x1f) == 0x1f) {
+            i = 0;
+            do {
+                if (ptr >= end) {
+                    return 0;
+                }
+                if (++i > 4) {
+                    return -1;
+                }
+            } while ((*(ptr++)) & 0x80);
+        }
+
+        if (ptr >= end) {
+            return 0;
+        }
+
+        if (((*ptr) & 0x80) == 0) {
+            vallen = *ptr;
+            ptr ++;
+        } else if ((lenoctets = ((*ptr) & 0x7f)) == 0) {
+            if ((tagbyte & 0x20) == 0) {
+                /* Primitive fields cannot be indefinite length */
+                return -1;
+            }
+            ptr ++;
+            indefdepth ++;
+            continue;
+        } else {
+            if (lenoctets > sizeof(uint64_t)) {
+                return -1;
+            }
+            if (end - ptr <= lenoctets) {
+                return 0;
+            }
+            ptr ++;
+            vallen = 0;
+            for (i = 0; i < lenoctets; i++) {
+                vallen = (vallen << 8) | (*ptr);
+                ptr ++;
+            }
+        }
+
+        if (vallen > (uint64_t)(end - ptr)) {
+            return 0;
+        }
+        ptr += vallen;
+    } while (indefdepth > 0);
+
+    return ptr - buf;
+}
+
+/* Splits a buffer containing back-to-back messages into individual
+ * messages, without decoding any of their contents.
+ *
+ * Up to 'maxframes' message locations are written into 'frames'. If
+ * 'consumed' is not NULL, it is set to the number of bytes covered by the
+ * returned frames -- anything beyond that is either an incomplete message
+ * or was not examined because 'frames' was full.
+ *
+ * Returns the number of frames found, or -1 if invalid data was
+ * encountered before any complete message was found.
+ */
+int wandder_find_frames(uint8_t *buf, uint32_t len, wandder_frame_t *frames,
+        int maxframes, uint32_t *consumed) {
+
+    uint32_t offset = 0;
+    int64_t msglen;
+    int found = 0;
+
+    while (found < maxframes && offset < len) {
+        msglen = wandder_get_message_length(buf + offset, len - offset);
+        if (msglen < 0) {
+            if (found == 0) {
+                if (consumed) {
+                    *consumed = 0;
+                }
+                return -1;
+            }
+            break;
+        }
+        if (msglen == 0) {
+            break;
+        }
+        frames[found].offset = offset;
+        frames[found].length = (uint32_t)msglen;
+        found ++;
+        offset += msglen;
+    }
+
+    if (consumed) {
+        *consumed = offset;
+    }
+    return found;
+}
+
+/* Streaming decoding
+ * ----------------------------------------------------
+ */
+
+wandder_stream_decoder_t *wandder_create_stream_decoder(void) {
+
+    wandder_stream_decoder_t *sdec;
+
+    sdec = (wandder_stream_decoder_t *)calloc(1,
+            sizeof(wandder_stream_decoder_t));
+    sdec->tape = wandder_create_tape(0);
+    return sdec;
+}
+
+void wandder_reset_stream_decoder(wandder_stream_decoder_t *sdec) {
+
+    sdec->tape->count = 0;
+    sdec->tape->source = NULL;
+    sdec->tape->sourcelen = 0;
+    sdec->consumed = 0;
+    sdec->complete = 0;
+    sdec->depth = 0;
+    sdec->hdrlen = 0;
+    sdec->contentrem = 0;
+}
+
+void wandder_free_stream_decoder(wandder_stream_decoder_t *sdec) {
+    if (sdec == NULL) {
+        return;
+    }
+    wandder_free_tape(sdec->tape);
+    free(sdec);
+}
+
+void wandder_stream_set_value_callback(wandder_stream_decoder_t *sdec,
+        wandder_stream_value_cb cb, void *cbdata) {
+
+    sdec->valuecb = cb;
+    sdec->cbdata = cbdata;
+}
+
+/* Checks whether the buffered header bytes make up a complete tag and
+ * length. Returns 1 if so (filling in the entry), 0 if more bytes are
+ * required and -1 if the header is invalid.
+ */
+static int stream_parse_header(wandder_stream_decoder_t *sdec,
+        wandder_tape_entry_t *e) {
+
+    uint8_t *h = sdec->hdr;
+    uint8_t i = 1, lenoctets, j;
+    uint64_t longlen = 0;
+
+    e->identclass = (h[0] & 0xe0) >> 5;
+    if ((h[0] & 0x1f) == 0x1f) {
+        e->identifier = 0;
+        do {
+            if (i >= sdec->hdrlen) {
+                return 0;
+            }
+            if (i == 5) {
+                return -1;
+            }
+            e->identifier = (e->identifier << 7) | (h[i] & 0x7f);
+        } while (h[i++] & 0x80);
+    } else {
+        e->identifier = h[0] & 0x1f;
+    }
+
+    if (i >= sdec->hdrlen) {
+        return 0;
+    }
+
+    e->indefform = 0;
+    if ((h[i] & 0x80) == 0) {
+        e->length = h[i];
+        i ++;
+    } else if ((lenoctets = (h[i] & 0x7f)) == 0) {
+        e->indefform = 1;
+        e->length = 0;
+        i ++;
+    } else {
+        if (lenoctets > sizeof(uint64_t)) {
+            return -1;
+        }
+        if (i + 1 + lenoctets > sdec->hdrlen) {
+            return 0;
+        }
+        i ++;
+        for (j = 0; j < lenoctets; j++) {
+            longlen = (longlen << 8) | h[i];
+            i ++;
+        }
+        if (longlen > UINT32_MAX) {
+            return -1;
+        }
+        e->length = (uint32_t)longlen;
+    }
+
+    e->preamblelen = i;
+    return 1;
+}
+
+/* Closes any open definite-length fields that end at the current position.
+ * Returns -1 if a field has overrun its parent, 1 if the whole message is
+ * now complete and 0 otherwise.
+ */
+static int stream_close_fields(wandder_stream_decoder_t *sdec) {
+
+    wandder_tape_entry_t *parent;
+    uint64_t parentend;
+
+    while (sdec->depth > 0) {
+        parent = &(sdec->tape->entries[sdec->open[sdec->depth - 1]]);
+        if (parent->indefform) {
+            break;
+        }
+        parentend = (uint64_t)parent->offset + parent->preamblelen +
+                parent->length;
+        if (sdec->consumed < parentend) {
+            break;
+        }
+        if (sdec->consumed > parentend) {
+            return -1;
+        }
+        parent->next = sdec->tape->count;
+        sdec->depth --;
+    }
+
+    if (sdec->depth == 0 && sdec->tape->count > 0) {
+        sdec->complete = 1;
+        sdec->tape->sourcelen = sdec->consumed;
+        return 1;
+    }
+    return 0;
+}
+
+/* Feeds the next 'len' bytes of the message into the stream decoder.
+ *
+ * Returns WANDDER_STREAM_COMPLETE once the end of the message has been
+ * reached, at which point sdec->tape describes the whole message (with
+ * offsets relative to the start of the message) and '*used' is set to the
+ * number of bytes from 'data' that belonged to it -- any remaining bytes
+ * are the start of the next message. The tape can only be used to read
+ * values once sdec->tape->source points at a contiguous copy of the
+ * message; otherwise use a value callback (see
+ * wandder_stream_set_value_callback()) to receive values as they arrive.
+ *
+ * Returns WANDDER_STREAM_NEED_MORE if all of 'data' was consumed and the
+ * message is not yet complete, or WANDDER_STREAM_ERROR if the data is
+ * not valid BER.
+ *
+ * Feeding a stream decoder that has completed a message will
+ * automatically start a new message.
+ */
+int wandder_stream_feed(wandder_stream_decoder_t *sdec, uint8_t *data,
+        uint32_t len, uint32_t *used) {
+
+    uint32_t pos = 0;
+    uint32_t skip;
+    wandder_tape_t *tape;
+    wandder_tape_entry_t *e, *parent;
+    int ret;
+
+    *used = 0;
+    if (sdec == NULL) {
+        fprintf(stderr, "libwandder cannot decode using a NULL stream decoder.\n");
+        return WANDDER_STREAM_ERROR;
+    }
+
+    if (sdec->complete) {
+        wandder_reset_stream_decoder(sdec);
+    }
+    tape = sdec->tape;
+
+    while (1) {
+        if (sdec->contentrem > 0) {
+            skip = len - pos;
+            if (sdec->contentrem < skip) {
+                skip = (uint32_t)sdec->contentrem;
+            }
+            if (sdec->valuecb && skip > 0) {
+                e = &(tape->entries[sdec->valueentry]);
+                if (sdec->valuecb(tape, sdec->valueentry, data + pos, skip,
+                            e->length - (uint32_t)sdec->contentrem,
+                            sdec->cbdata) < 0) {
+                    *used = pos;
+                    return WANDDER_STREAM_ERROR;
+                }
+            }
+            sdec->contentrem -= skip;
+            sdec->consumed += skip;
+            pos += skip;
+            if (sdec->contentrem > 0) {
+                break;
+            }
+        }
+
+        if (sdec->hdrlen == 0) {
+            ret = stream_close_fields(sdec);
+            if (ret < 0) {
+                *used = pos;
+                return WANDDER_STREAM_ERROR;
+            }
+            if (ret == 1) {
+                *used = pos;
+                return WANDDER_STREAM_COMPLETE;
+            }
+        }
+
+        if (pos == len) {
+            break;
+        }
+
+        if (sdec->hdrlen == sizeof(sdec->hdr)) {
+            *used = pos;
+            return WANDDER_STREAM_ERROR;
+        }
+        sdec->hdr[sdec->hdrlen++] = data[pos++];
+
+        if (tape->count == tape->alloced) {
+            tape->alloced *= 2;
+            tape->entries = (wandder_tape_entry_t *)realloc(tape->entries,
+                    tape->alloced * sizeof(wandder_tape_entry_t));
+        }
+        e = &(tape->entries[tape->count]);
+
+        if ((ret = stream_parse_header(sdec, e)) == 0) {
+            continue;
+        }
+        if (ret < 0) {
+            *used = pos;
+            return WANDDER_STREAM_ERROR;
+        }
+
+        e->offset = sdec->consumed;
+        e->level = sdec->depth;
+        sdec->consumed += sdec->hdrlen;
+        sdec->hdrlen = 0;
+
+        if (sdec->depth > 0) {
+            /* Reject fields that claim more bytes than their parent has
+             * left now, rather than after we've read all of them */
+            parent = &(tape->entries[sdec->open[sdec->depth - 1]]);
+            if (!parent->indefform && (uint64_t)sdec->consumed + e->length >
+                    (uint64_t)parent->offset + parent->preamblelen +
+                    parent->length) {
+                *used = pos;
+                return WANDDER_STREAM_ERROR;
+            }
+        }
+
+        if (sdec->depth > 0 && e->identclass == 0 && e->identifier == 0 &&
+                e->length == 0 && !e->indefform) {
+            parent = &(tape->entries[sdec->open[sdec->depth - 1]]);
+            if (parent->indefform) {
+                /* End of contents for an indefinite length field */
+                parent->length = e->offset - parent->offset -
+                        parent->preamblelen;
+                parent->next = tape->count;
+                sdec->depth --;
+                continue;
+            }
+        }
+
+        if (e->indefform && !IS_CONSTRUCTED(e)) {
+            *used = pos;
+            return WANDDER_STREAM_ERROR;
+        }
+
+        tape->count ++;
+        if (IS_CONSTRUCTED(e)) {
+            if (sdec->depth == WANDDER_TAPE_MAX_DEPTH) {
+                fprintf(stderr, "libwandder tape cannot handle messages nested more than %d levels deep\n", WANDDER_TAPE_MAX_DEPTH);
+                *used = pos;
+                return WANDDER_STREAM_ERROR;
+            }
+            sdec->open[sdec->depth] = tape->count - 1;
+            sdec->depth ++;
+        } else {
+            e->next = tape->count;
+            sdec->contentrem = e->length;
+            sdec->valueentry = tape->count - 1;
+        }
+    }
+
+    *used = pos;
+    return WANDDER_STREAM_NEED_MORE;
+}
+
 // vim: set sw=4 tabstop=4 softtabstop=4 expandtab :
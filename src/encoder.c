@@ -53,7 +53,6 @@ wandder_encoder_t *init_wandder_encoder(void) {
     wandder_encoder_t *enc = (wandder_encoder_t *)calloc(1,
             sizeof(wandder_encoder_t));
 
-    pthread_mutex_init(&(enc->mutex), NULL);
     return enc;
 }
 
@@ -81,6 +80,7 @@ void reset_wandder_encoder(wandder_encoder_t *enc) {
 void free_wandder_encoder(wandder_encoder_t *enc) {
     wandder_pend_t *p, *tmp;
     wandder_encoded_result_t *res, *restmp;
+    int i;
 
     reset_wandder_encoder(enc);
     p = enc->freelist;
@@ -98,17 +98,28 @@ void free_wandder_encoder(wandder_encoder_t *enc) {
         free(tmp);
     }
 
-    pthread_mutex_lock(&(enc->mutex));
-    res = enc->freeresults;
+    /* Any results still held by other threads must be released before the
+     * encoder is freed.
+     */
+    for (i = 0; i < WANDDER_RESULT_SIZE_CLASSES; i++) {
+        res = enc->freeresults[i];
+        while (res) {
+            restmp = res;
+            res = res->next;
+            free(restmp->encoded);
+            free(restmp);
+        }
+    }
+
+    res = __atomic_exchange_n(&(enc->returnedresults), NULL,
+            __ATOMIC_ACQUIRE);
     while (res) {
         restmp = res;
         res = res->next;
         free(restmp->encoded);
         free(restmp);
     }
-    pthread_mutex_unlock(&(enc->mutex));
 
-    pthread_mutex_destroy(&(enc->mutex));
     free(enc);
 }
 
@@ -328,29 +339,31 @@ static uint32_t encode_oid(wandder_encode_job_t *p, void *valptr,
     return len - 1;
 }
 
-static inline uint32_t encode_integer(wandder_encode_job_t *p, void *valptr,
-        uint32_t len) {
+/* Works out how many octets are needed to encode the integer at 'valptr'
+ * and saves its value into 'val'.
+ *
+ * Returns the number of octets, or 0 if 'len' is not a valid integer size.
+ */
+static inline uint16_t integer_octets(void *valptr, uint32_t len,
+        int64_t *val) {
 
-    int64_t val;
     uint16_t lenocts;
-    uint8_t *ptr;
-    int i;
 
     if (len == 8) {
-        val = *((int64_t *)valptr);
+        *val = *((int64_t *)valptr);
     } else if (len == 4) {
-        val = *((int32_t *)valptr);
+        *val = *((int32_t *)valptr);
     } else {
         fprintf(stderr, "Encode error: unexpected length for integer type: %u\n",
                 len);
         return 0;
     }
 
-    if (val < 0) {
+    if (*val < 0) {
         /* Play it safe with negative numbers (or seemingly negative ones) */
         lenocts = len;
     } else {
-        lenocts = WANDDER_LOG256_SIZE(val);
+        lenocts = WANDDER_LOG256_SIZE(*val);
         if (lenocts == 0) {
             lenocts = 1;
         }
@@ -358,11 +371,27 @@ static inline uint32_t encode_integer(wandder_encode_job_t *p, void *valptr,
         if (lenocts > 7) {
             lenocts = len;
         }
-        if (lenocts < len && val >= WANDDER_EXTRA_OCTET_THRESH(lenocts)) { 
+        if (lenocts < len && *val >= WANDDER_EXTRA_OCTET_THRESH(lenocts)) { 
             lenocts ++;
         }
     }
 
+    return lenocts;
+}
+
+static inline uint32_t encode_integer(wandder_encode_job_t *p, void *valptr,
+        uint32_t len) {
+
+    int64_t val;
+    uint16_t lenocts;
+    uint8_t *ptr;
+    int i;
+
+    lenocts = integer_octets(valptr, len, &val);
+    if (lenocts == 0) {
+        return 0;
+    }
+
     VALALLOC(lenocts, p);
     p->vallen = lenocts;
     ptr = p->valspace;
@@ -375,13 +404,83 @@ static inline uint32_t encode_integer(wandder_encode_job_t *p, void *valptr,
     return lenocts;
 }
 
+#define PUT_TWO_DIGITS(ptr, val) \
+    (ptr)[0] = '0' + ((val) / 10); \
+    (ptr)[1] = '0' + ((val) % 10);
+
+/* The "YYYYmmddHHMMSS" string for the most recently encoded second. Most
+ * timestamps are close together, so we can usually just re-use this and
+ * only write the milliseconds.
+ */
+typedef struct encoded_time_cache {
+    uint8_t valid;
+    int64_t sec;
+    char prefix[14];
+} encoded_time_cache_t;
+
+static __thread encoded_time_cache_t timecache;
+
+/* Converts a count of days since 1970-01-01 into a (proleptic) Gregorian
+ * year, month and day.
+ */
+static inline void civil_from_days(int64_t days, int64_t *y, int *m,
+        int *d) {
+
+    int64_t era, doe, yoe, doy, mp;
+
+    days += 719468;
+    era = (days >= 0 ? days : days - 146096) / 146097;
+    doe = days - era * 146097;
+    yoe = (doe - doe / 1460 + doe / 36524 - doe / 146096) / 365;
+    doy = doe - (365 * yoe + yoe / 4 - yoe / 100);
+    mp = (5 * doy + 2) / 153;
+    *d = (int)(doy - (153 * mp + 2) / 5 + 1);
+    *m = (int)(mp < 10 ? mp + 3 : mp - 9);
+    *y = yoe + era * 400 + (*m <= 2);
+}
+
+static inline int update_time_cache(int64_t sec) {
+
+    int64_t days, secofday, year;
+    int month, day;
+    char *ptr = timecache.prefix;
+
+    days = sec / 86400;
+    secofday = sec % 86400;
+    if (secofday < 0) {
+        secofday += 86400;
+        days -= 1;
+    }
+
+    civil_from_days(days, &year, &month, &day);
+    if (year < 0 || year > 9999) {
+        fprintf(stderr, "Encode error: timestamp %" PRId64 " is out of range\n",
+                sec);
+        return 0;
+    }
+
+    PUT_TWO_DIGITS(ptr, year / 100);
+    PUT_TWO_DIGITS(ptr + 2, year % 100);
+    PUT_TWO_DIGITS(ptr + 4, month);
+    PUT_TWO_DIGITS(ptr + 6, day);
+    PUT_TWO_DIGITS(ptr + 8, secofday / 3600);
+    PUT_TWO_DIGITS(ptr + 10, (secofday / 60) % 60);
+    PUT_TWO_DIGITS(ptr + 12, secofday % 60);
+
+    timecache.sec = sec;
+    timecache.valid = 1;
+    return 1;
+}
+
+/* Writes the time string for 'tv' into 'out', which must have room for at
+ * least MAX_ENCODED_TIME_LEN bytes. The string is NOT null-terminated.
+ *
+ * Returns the number of bytes written, or 0 if an error occurs.
+ */
 static inline int encode_time_inline(
-        uint32_t len, struct timeval *tv, char* returnbuf, int time_format,
-        int retbuflen) {
-    
-    struct tm tm;
-    time_t tstamp;
-    char timebuf[768];
+        uint32_t len, struct timeval *tv, char *out, int time_format) {
+
+    int ms;
 
     if (len != sizeof(struct timeval)) {
         fprintf(stderr, "Encode error: unexpected length for timeval: %u\n",
@@ -389,50 +488,64 @@ static inline int encode_time_inline(
         return 0;
     }
 
-    tstamp = tv->tv_sec;
-    if (gmtime_r(&tstamp, &tm) == NULL) {
-        fprintf(stderr, "Encode error: failed to convert timeval to tm\n");
-        return 0;
+    if (!timecache.valid || timecache.sec != (int64_t)tv->tv_sec) {
+        if (update_time_cache((int64_t)tv->tv_sec) == 0) {
+            return 0;
+        }
     }
 
-    strftime(timebuf, 768, "%Y%m%d%H%M%S", &tm);
-
     switch (time_format) {
-        case WANDDER_G_TIME: 
-            strftime(timebuf, 768, "%Y%m%d%H%M%S", &tm);
-            snprintf(returnbuf, retbuflen, "%s.%03" PRId64 "Z", timebuf,
-                    (int64_t)(tv->tv_usec / 1000));
-            break;
+        case WANDDER_G_TIME:
+            ms = (int)((tv->tv_usec / 1000) % 1000);
+            memcpy(out, timecache.prefix, 14);
+            out[14] = '.';
+            out[15] = '0' + (ms / 100);
+            PUT_TWO_DIGITS(out + 16, ms % 100);
+            out[18] = 'Z';
+            return 19;
         default:
-            fprintf(stderr, 
+            fprintf(stderr,
                 "Encode error: unexpected format for timeval, using UTC\n");
         case WANDDER_UTC_TIME:
-            strftime(timebuf, 768, "%y%m%d%H%M%S", &tm);
-            snprintf(returnbuf, retbuflen, "%sZ", timebuf);
-            break;
+            memcpy(out, timecache.prefix + 2, 12);
+            out[12] = 'Z';
+            return 13;
     }
 
-    return strlen(returnbuf);
+    return 0;
 }
 
 int wandder_timeval_to_generalizedts(struct timeval *tv, char *gts, int space) {
-    return encode_time_inline(sizeof(struct timeval), tv, gts, WANDDER_G_TIME, space);
+
+    char timebuf[MAX_ENCODED_TIME_LEN];
+    int towrite;
+
+    if (space <= 0) {
+        return 0;
+    }
+
+    towrite = encode_time_inline(sizeof(struct timeval), tv, timebuf,
+            WANDDER_G_TIME);
+    if (towrite >= space) {
+        towrite = space - 1;
+    }
+    memcpy(gts, timebuf, towrite);
+    gts[towrite] = '\0';
+    return towrite;
 }
 
 static uint32_t encode_time(wandder_encode_job_t *p, void *valptr,
         uint32_t len, int time_format) {
 
     struct timeval *tv = (struct timeval *)valptr;
-    char timebuf[1024];
+    int towrite;
 
-    int towrite = encode_time_inline(len, tv, timebuf, time_format, 1024);
+    VALALLOC(MAX_ENCODED_TIME_LEN, p);
+    towrite = encode_time_inline(len, tv, (char *)p->valspace, time_format);
     if (towrite == 0)
         return  0;
 
-    VALALLOC(towrite, p);
     p->vallen = towrite;
-
-    memcpy(p->valspace, timebuf, towrite);
     return (uint32_t)towrite;
 }
 
@@ -441,25 +554,26 @@ static uint32_t encode_time_ber(void *valptr,
 
     struct timeval *tv = (struct timeval *)valptr;
     size_t ret;
-    char timebuf[1024];
+    int towrite;
+
+    /* The length of the time string is always less than 128 so the
+     * length field is always a single byte and we can format straight into
+     * the output buffer.
+     */
+    if (rem < MAX_ENCODED_TIME_LEN + 1) {
+        fprintf(stderr, "Encode error: not enough space left to encode timestamp\n");
+        return 0;
+    }
 
-    int towrite = encode_time_inline(len, tv, timebuf, time_format, 1024);
+    towrite = encode_time_inline(len, tv, (char *)buf + 1, time_format);
     if (towrite == 0)
         return  0;
 
     ret = encode_length(towrite, buf, rem);
-    buf += ret;
-    rem -= ret;
-
-    memcpy(buf, timebuf, towrite);
-    buf += towrite;
-    rem -= towrite;
-
     return towrite + ret;
 }
 
 
-
 static inline void save_value_to_encode(wandder_encode_job_t *job, void *valptr,
         uint32_t vallen) {
 
@@ -834,14 +948,32 @@ uint32_t encode_r(wandder_pend_t *p, uint8_t *buf, uint32_t rem) {
     return tot;
 }
 
+/* Pushes a chain of results onto the encoder's return list. This may be
+ * called from any thread. The list is only ever emptied as a whole (see
+ * take_free_result()), so a compare-and-swap push is safe from ABA.
+ */
+static inline void return_results(wandder_encoder_t *enc,
+        wandder_encoded_result_t *res, wandder_encoded_result_t *tail) {
+
+    wandder_encoded_result_t *head;
+
+    head = __atomic_load_n(&(enc->returnedresults), __ATOMIC_RELAXED);
+    do {
+        tail->next = head;
+    } while (!__atomic_compare_exchange_n(&(enc->returnedresults), &head,
+            res, true, __ATOMIC_RELEASE, __ATOMIC_RELAXED));
+}
+
 void wandder_release_encoded_result(wandder_encoder_t *enc,
         wandder_encoded_result_t *res) {
 
-    if (enc && pthread_mutex_trylock(&(enc->mutex)) == 0) {
-        res->next = enc->freeresults;
-        enc->freeresults = res;
-        pthread_mutex_unlock(&(enc->mutex));
-    } else if (res) {
+    if (res == NULL) {
+        return;
+    }
+
+    if (enc) {
+        return_results(enc, res, res);
+    } else {
         if (res->encoded) {
             free(res->encoded);
         }
@@ -865,42 +997,149 @@ void wandder_release_encoded_results(wandder_encoder_t *enc,
         return;
     }
 
-    pthread_mutex_lock(&(enc->mutex));
+    if (res == NULL) {
+        return;
+    }
+    return_results(enc, res, tail);
+}
+
+/* Returns the size class for a result of 'len' bytes, or -1 if it is too
+ * big for any of the classes.
+ */
+static inline int result_size_class(uint32_t len) {
+    int cls = 0;
+    uint32_t size = WANDDER_RESULT_MIN_CLASS_SIZE;
+
+    while (size < len) {
+        cls ++;
+        if (cls == WANDDER_RESULT_SIZE_CLASSES) {
+            return -1;
+        }
+        size = size << 1;
+    }
+    return cls;
+}
+
+static inline void discard_result(wandder_encoder_t *enc,
+        wandder_encoded_result_t *res) {
+
+    enc->resultstats.discarded ++;
+    free(res->encoded);
+    free(res);
+}
+
+/* Sorts everything that other threads have released into the per-class
+ * free lists, freeing anything that is oversized or would take the pool
+ * over its cap.
+ *
+ * Must only be called by the thread that is doing the encoding.
+ */
+static void sort_returned_results(wandder_encoder_t *enc) {
+
+    wandder_encoded_result_t *res, *next;
+    wandder_encoded_result_stats_t *stats = &(enc->resultstats);
+    int cls;
 
-    tail->next = enc->freeresults;
-    enc->freeresults = res;
+    res = __atomic_exchange_n(&(enc->returnedresults), NULL,
+            __ATOMIC_ACQUIRE);
 
-    pthread_mutex_unlock(&(enc->mutex));
+    while (res) {
+        next = res->next;
+        cls = result_size_class(res->alloced);
+
+        if (cls < 0 || (enc->resultpoolcap > 0 &&
+                    stats->pooledbytes + res->alloced > enc->resultpoolcap)) {
+            discard_result(enc, res);
+        } else {
+            res->next = enc->freeresults[cls];
+            enc->freeresults[cls] = res;
+            stats->pooled[cls] ++;
+            stats->pooledbytes += res->alloced;
+        }
+        res = next;
+    }
+}
+
+/* Must only be called by the thread that is doing the encoding */
+static inline wandder_encoded_result_t *take_free_result(
+        wandder_encoder_t *enc, int cls) {
+
+    wandder_encoded_result_t *result;
+
+    if (enc->freeresults[cls] == NULL) {
+        /* Grab everything the other threads have handed back so far */
+        sort_returned_results(enc);
+    }
+
+    result = enc->freeresults[cls];
+    if (result) {
+        enc->freeresults[cls] = result->next;
+        enc->resultstats.pooled[cls] --;
+        enc->resultstats.pooledbytes -= result->alloced;
+        enc->resultstats.reused ++;
+    }
+    return result;
+}
+
+void wandder_set_encoded_result_pool_cap(wandder_encoder_t *enc,
+        uint64_t maxbytes) {
+
+    wandder_encoded_result_t *res;
+    int cls;
+
+    enc->resultpoolcap = maxbytes;
+    if (maxbytes == 0) {
+        return;
+    }
+
+    /* Trim the biggest results first, they free the most memory */
+    for (cls = WANDDER_RESULT_SIZE_CLASSES - 1; cls >= 0; cls--) {
+        while (enc->resultstats.pooledbytes > maxbytes &&
+                enc->freeresults[cls] != NULL) {
+            res = enc->freeresults[cls];
+            enc->freeresults[cls] = res->next;
+            enc->resultstats.pooled[cls] --;
+            enc->resultstats.pooledbytes -= res->alloced;
+            discard_result(enc, res);
+        }
+    }
+}
+
+void wandder_get_encoded_result_stats(wandder_encoder_t *enc,
+        wandder_encoded_result_stats_t *stats) {
+
+    memcpy(stats, &(enc->resultstats), sizeof(wandder_encoded_result_stats_t));
 }
 
 wandder_encoded_result_t *wandder_encode_finish(wandder_encoder_t *enc) {
 
     wandder_encoded_result_t *result = NULL;
+    uint32_t len;
+    int cls;
 
-    if (enc->freeresults && pthread_mutex_trylock(&(enc->mutex)) == 0) {
-        result = enc->freeresults;
-        enc->freeresults = result->next;
-        pthread_mutex_unlock(&(enc->mutex));
-    } else {
+    len = enc->pendlist->childrensize + enc->pendlist->thisjob.preamblen;
+    cls = result_size_class(len);
+
+    if (cls >= 0) {
+        result = take_free_result(enc, cls);
+    }
+
+    if (result == NULL) {
         result = (wandder_encoded_result_t *)calloc(1,
                 sizeof(wandder_encoded_result_t));
-        result->encoded = NULL;
-        result->len = 0;
-        result->alloced = 0;
+        if (cls >= 0) {
+            result->alloced = WANDDER_RESULT_MIN_CLASS_SIZE << cls;
+            enc->resultstats.allocated ++;
+        } else {
+            result->alloced = len;
+            enc->resultstats.oversized ++;
+        }
+        result->encoded = (uint8_t *)malloc(result->alloced);
     }
 
     result->encoder = enc;
     result->next = NULL;
-    result->len = enc->pendlist->childrensize + enc->pendlist->thisjob.preamblen;
-
-    if (result->alloced < result->len) {
-        uint32_t x = 512;
-        if (x < result->len) {
-            x = result->len;
-        }
-        result->encoded = (uint8_t *)realloc(result->encoded, x);
-        result->alloced = x;
-    }
+    result->len = len;
 
     if (encode_r(enc->pendlist, result->encoded, result->len) == 0) {
         fprintf(stderr, "Failed to encode wandder structure\n");
@@ -911,6 +1150,670 @@ wandder_encoded_result_t *wandder_encode_finish(wandder_encoder_t *enc) {
     return result;
 }
 
+/* Reverse DER encoder
+ * ----------------------------------------------------
+ */
+
+static inline uint32_t identifier_octets(uint32_t ident) {
+    uint32_t octs = 1;
+
+    if (ident <= 30) {
+        return 1;
+    }
+
+    while (ident > 0) {
+        octs ++;
+        ident = ident >> 7;
+    }
+    return octs;
+}
+
+static inline uint32_t length_octets(uint32_t len) {
+    uint32_t lenocts;
+
+    if (len < 128) {
+        return 1;
+    }
+
+    /* Must match the number of octets that encode_length() will use */
+    lenocts = WANDDER_LOG256_SIZE(len);
+    if (len > WANDDER_EXTRA_OCTET_THRESH(lenocts)) {
+        lenocts ++;
+    }
+    return lenocts + 1;
+}
+
+wandder_der_rev_encoder_t *wandder_init_der_rev_encoder(size_t init_alloc) {
+
+    wandder_der_rev_encoder_t *enc = (wandder_der_rev_encoder_t *)calloc(1,
+            sizeof(wandder_der_rev_encoder_t));
+
+    if (init_alloc == 0) {
+        init_alloc = 512;
+    }
+    enc->buf = (uint8_t *)malloc(init_alloc);
+    enc->alloced = init_alloc;
+    return enc;
+}
+
+void wandder_reset_der_rev_encoder(wandder_der_rev_encoder_t *enc) {
+    enc->used = 0;
+    enc->depth = 0;
+}
+
+void wandder_free_der_rev_encoder(wandder_der_rev_encoder_t *enc) {
+    if (enc == NULL) {
+        return;
+    }
+    free(enc->buf);
+    free(enc);
+}
+
+/* Makes room for 'n' more bytes in front of everything that has been written
+ * so far and returns a pointer to the first of them.
+ *
+ * The encoded data lives at the end of the buffer, so growing the buffer
+ * means moving that data to the end of the new one.
+ */
+static inline uint8_t *der_rev_reserve(wandder_der_rev_encoder_t *enc,
+        size_t n) {
+
+    if (enc->alloced - enc->used < n) {
+        size_t newsize = enc->alloced * 2;
+        uint8_t *newbuf;
+
+        if (newsize < enc->used + n) {
+            newsize = enc->used + n + 512;
+        }
+        newbuf = (uint8_t *)malloc(newsize);
+        if (newbuf == NULL) {
+            fprintf(stderr, "Encode error: unable to grow reverse DER buffer to %zu bytes\n",
+                    newsize);
+            assert(0);
+            return NULL;
+        }
+        memcpy(newbuf + newsize - enc->used,
+                enc->buf + enc->alloced - enc->used, enc->used);
+        free(enc->buf);
+        enc->buf = newbuf;
+        enc->alloced = newsize;
+    }
+
+    enc->used += n;
+    return enc->buf + enc->alloced - enc->used;
+}
+
+/* Writes the identifier and length in front of a value of 'len' bytes that
+ * has already been written.
+ */
+static int der_rev_header(wandder_der_rev_encoder_t *enc, uint8_t itemclass,
+        uint32_t idnum, uint32_t len) {
+
+    uint32_t idlen, lenlen;
+    uint8_t *ptr;
+
+    if (itemclass == WANDDER_CLASS_UNKNOWN) {
+        fprintf(stderr, "Encode error: class was unknown\n");
+        return -1;
+    }
+
+    idlen = identifier_octets(idnum);
+    lenlen = length_octets(len);
+    ptr = der_rev_reserve(enc, idlen + lenlen);
+    if (ptr == NULL) {
+        return -1;
+    }
+
+    if (idnum <= 30) {
+        encode_identifier_fast(itemclass, idnum, ptr);
+    } else if (encode_identifier(itemclass, idnum, ptr, idlen) == 0) {
+        return -1;
+    }
+
+    if (encode_length(len, ptr + idlen, lenlen) == 0) {
+        return -1;
+    }
+    return idlen + lenlen;
+}
+
+/* Encodes a primitive field in front of everything written so far.
+ *
+ * For WANDDER_TAG_IPPACKET, valptr may be NULL in which case the space for
+ * the packet is reserved but left for the caller to fill in.
+ *
+ * Returns the number of bytes written, or -1 if an error occurs (in which
+ * case the encoder should be reset before it is used again).
+ */
+int wandder_der_rev_encode(wandder_der_rev_encoder_t *enc, uint8_t encodeas,
+        uint8_t itemclass, uint32_t idnum, void *valptr, uint32_t vallen) {
+
+    uint8_t *ptr;
+    uint8_t *cast = (uint8_t *)valptr;
+    char timebuf[MAX_ENCODED_TIME_LEN];
+    uint32_t written = 0;
+    uint16_t lenocts;
+    int64_t val;
+    int ret, i;
+
+    if (itemclass == WANDDER_CLASS_ALREADY_ENCODED ||
+            encodeas == WANDDER_TAG_ALREADY_ENCODED) {
+        if ((ptr = der_rev_reserve(enc, vallen)) == NULL) {
+            return -1;
+        }
+        memcpy(ptr, valptr, vallen);
+        return (int)vallen;
+    }
+
+    switch(encodeas) {
+        case WANDDER_TAG_OCTETSTRING:
+        case WANDDER_TAG_UTF8STR:
+        case WANDDER_TAG_NUMERIC:
+        case WANDDER_TAG_PRINTABLE:
+        case WANDDER_TAG_IA5:
+        case WANDDER_TAG_RELATIVEOID:
+        case WANDDER_TAG_IPPACKET:
+            if ((ptr = der_rev_reserve(enc, vallen)) == NULL) {
+                return -1;
+            }
+            if (valptr) {
+                memcpy(ptr, valptr, vallen);
+            }
+            written = vallen;
+            break;
+
+        case WANDDER_TAG_UTCTIME:
+        case WANDDER_TAG_GENERALTIME:
+            ret = encode_time_inline(vallen, (struct timeval *)valptr,
+                    timebuf, encodeas == WANDDER_TAG_UTCTIME ?
+                    WANDDER_UTC_TIME : WANDDER_G_TIME);
+            if (ret == 0) {
+                return -1;
+            }
+            if ((ptr = der_rev_reserve(enc, ret)) == NULL) {
+                return -1;
+            }
+            memcpy(ptr, timebuf, ret);
+            written = ret;
+            break;
+
+        case WANDDER_TAG_INTEGER:
+        case WANDDER_TAG_ENUM:
+            lenocts = integer_octets(valptr, vallen, &val);
+            if (lenocts == 0) {
+                return -1;
+            }
+            if ((ptr = der_rev_reserve(enc, lenocts)) == NULL) {
+                return -1;
+            }
+            for (i = lenocts - 1; i >= 0; i--) {
+                ptr[i] = (val & 0xff);
+                val = val >> 8;
+            }
+            written = lenocts;
+            break;
+
+        case WANDDER_TAG_OID:
+            if (vallen < 2) {
+                fprintf(stderr, "Encode error: OID is too short!\n");
+                return -1;
+            }
+            if ((ptr = der_rev_reserve(enc, vallen - 1)) == NULL) {
+                return -1;
+            }
+            ptr[0] = (40 * cast[0]) + cast[1];
+            memcpy(ptr + 1, cast + 2, vallen - 2);
+            written = vallen - 1;
+            break;
+
+        case WANDDER_TAG_NULL:
+            break;
+
+        case WANDDER_TAG_SEQUENCE:
+        case WANDDER_TAG_SET:
+            fprintf(stderr, "Encode error: constructed fields must be encoded using wandder_der_rev_mark() and wandder_der_rev_wrap()\n");
+            return -1;
+
+        default:
+            fprintf(stderr, "Encode error: unable to encode tag type %d\n",
+                    encodeas);
+            return -1;
+    }
+
+    if ((ret = der_rev_header(enc, itemclass, idnum, written)) < 0) {
+        return -1;
+    }
+    return (int)written + ret;
+}
+
+/* Marks the end of the contents of a new constructed field. Everything
+ * written between now and the matching call to wandder_der_rev_wrap()
+ * becomes the contents of that field.
+ */
+int wandder_der_rev_mark(wandder_der_rev_encoder_t *enc) {
+
+    if (enc->depth >= WANDDER_DER_REV_MAX_DEPTH) {
+        fprintf(stderr, "Encode error: constructed fields are nested more than %d deep\n",
+                WANDDER_DER_REV_MAX_DEPTH);
+        return -1;
+    }
+
+    enc->marks[enc->depth] = enc->used;
+    enc->depth ++;
+    return 0;
+}
+
+/* Writes the header for the most recently marked constructed field, now
+ * that the length of its contents is known.
+ *
+ * Returns the total length of the constructed field, or -1 if an error
+ * occurs.
+ */
+int wandder_der_rev_wrap(wandder_der_rev_encoder_t *enc, uint8_t itemclass,
+        uint32_t idnum) {
+
+    size_t contentlen;
+    int ret;
+
+    if (enc->depth == 0) {
+        fprintf(stderr, "Encode error: no constructed field to wrap\n");
+        return -1;
+    }
+
+    enc->depth --;
+    contentlen = enc->used - enc->marks[enc->depth];
+    if (contentlen > UINT32_MAX) {
+        fprintf(stderr, "Encode error: constructed field is too long (%zu bytes)\n",
+                contentlen);
+        return -1;
+    }
+
+    if ((ret = der_rev_header(enc, itemclass, idnum,
+                    (uint32_t)contentlen)) < 0) {
+        return -1;
+    }
+    return (int)contentlen + ret;
+}
+
+/* Returns a pointer to the start of the complete encoding and sets 'len' to
+ * its length. The encoding remains owned by the encoder and is only valid
+ * until the encoder is next written to, reset or freed.
+ */
+uint8_t *wandder_der_rev_finish(wandder_der_rev_encoder_t *enc, size_t *len) {
+
+    if (enc->depth != 0) {
+        fprintf(stderr, "Encode error: %u constructed fields were not wrapped\n",
+                enc->depth);
+        return NULL;
+    }
+
+    *len = enc->used;
+    return enc->buf + enc->alloced - enc->used;
+}
+
+/* DER encode plans
+ * ----------------------------------------------------
+ */
+
+struct wandder_der_plan_node {
+    uint8_t encodeas;
+    uint8_t itemclass;
+    uint32_t idnum;
+    int64_t slot;           /* -1 if this is a constant field */
+    uint8_t hasslot;        /* Set if this node or any descendant is a slot */
+    uint8_t *value;
+    uint32_t vallen;
+
+    wandder_der_plan_node_t *parent;
+    wandder_der_plan_node_t *lastchild;
+    wandder_der_plan_node_t *prevsibling;
+};
+
+static void free_plan_nodes(wandder_der_plan_node_t *node) {
+    wandder_der_plan_node_t *child, *tmp;
+
+    if (node == NULL) {
+        return;
+    }
+
+    child = node->lastchild;
+    while (child) {
+        tmp = child;
+        child = child->prevsibling;
+        free_plan_nodes(tmp);
+    }
+    free(node->value);
+    free(node);
+}
+
+wandder_der_plan_t *wandder_create_der_plan(void) {
+
+    wandder_der_plan_t *plan = (wandder_der_plan_t *)calloc(1,
+            sizeof(wandder_der_plan_t));
+
+    /* The root is a placeholder for the top level and is never encoded
+     * itself, so the plan may hold more than one top-level field.
+     */
+    plan->root = (wandder_der_plan_node_t *)calloc(1,
+            sizeof(wandder_der_plan_node_t));
+    plan->root->slot = -1;
+    plan->current = plan->root;
+    return plan;
+}
+
+void wandder_free_der_plan(wandder_der_plan_t *plan) {
+    if (plan == NULL) {
+        return;
+    }
+    free_plan_nodes(plan->root);
+    free(plan->ops);
+    free(plan->consts);
+    free(plan);
+}
+
+static wandder_der_plan_node_t *new_plan_node(wandder_der_plan_t *plan,
+        uint8_t encodeas, uint8_t itemclass, uint32_t idnum) {
+
+    wandder_der_plan_node_t *node;
+
+    if (plan->compiled) {
+        fprintf(stderr, "Encode error: cannot add fields to a compiled DER plan\n");
+        return NULL;
+    }
+
+    if (itemclass == WANDDER_CLASS_UNKNOWN) {
+        fprintf(stderr, "Encode error: class was unknown\n");
+        return NULL;
+    }
+
+    node = (wandder_der_plan_node_t *)calloc(1,
+            sizeof(wandder_der_plan_node_t));
+    node->encodeas = encodeas;
+    node->itemclass = itemclass;
+    node->idnum = idnum;
+    node->slot = -1;
+    node->parent = plan->current;
+    node->prevsibling = plan->current->lastchild;
+    plan->current->lastchild = node;
+    return node;
+}
+
+int wandder_der_plan_add(wandder_der_plan_t *plan, uint8_t encodeas,
+        uint8_t itemclass, uint32_t idnum, void *valptr, uint32_t vallen) {
+
+    wandder_der_plan_node_t *node;
+
+    node = new_plan_node(plan, encodeas, itemclass, idnum);
+    if (node == NULL) {
+        return -1;
+    }
+
+    if (itemclass != WANDDER_CLASS_ALREADY_ENCODED && (itemclass & 0x01)) {
+        /* Subsequent fields are children of this one until endseq */
+        plan->current = node;
+        return 0;
+    }
+
+    if (vallen > 0) {
+        node->value = (uint8_t *)malloc(vallen);
+        memcpy(node->value, valptr, vallen);
+    }
+    node->vallen = vallen;
+    return 0;
+}
+
+int wandder_der_plan_add_slot(wandder_der_plan_t *plan, uint8_t encodeas,
+        uint8_t itemclass, uint32_t idnum) {
+
+    wandder_der_plan_node_t *node, *p;
+
+    if (itemclass != WANDDER_CLASS_ALREADY_ENCODED && (itemclass & 0x01)) {
+        fprintf(stderr, "Encode error: DER plan slots cannot be constructed fields\n");
+        return -1;
+    }
+
+    node = new_plan_node(plan, encodeas, itemclass, idnum);
+    if (node == NULL) {
+        return -1;
+    }
+
+    node->slot = plan->slotcount;
+    plan->slotcount ++;
+
+    for (p = node; p != NULL; p = p->parent) {
+        p->hasslot = 1;
+    }
+    return (int)node->slot;
+}
+
+int wandder_der_plan_endseq(wandder_der_plan_t *plan) {
+    if (plan->compiled || plan->current == plan->root) {
+        fprintf(stderr, "Encode error: no open sequence in DER plan\n");
+        return -1;
+    }
+    plan->current = plan->current->parent;
+    return 0;
+}
+
+static wandder_der_plan_op_t *new_plan_op(wandder_der_plan_t *plan,
+        uint8_t optype) {
+
+    wandder_der_plan_op_t *op;
+
+    if (plan->opcount == plan->opalloced) {
+        plan->opalloced += 16;
+        plan->ops = (wandder_der_plan_op_t *)realloc(plan->ops,
+                plan->opalloced * sizeof(wandder_der_plan_op_t));
+        if (plan->ops == NULL) {
+            fprintf(stderr, "Encode error: unable to grow DER plan\n");
+            assert(0);
+        }
+    }
+
+    op = &(plan->ops[plan->opcount]);
+    memset(op, 0, sizeof(wandder_der_plan_op_t));
+    op->optype = optype;
+    plan->opcount ++;
+    return op;
+}
+
+/* Adds pre-encoded bytes to the plan. Consecutive constants are merged into
+ * a single copy -- because the plan runs back to front, the new bytes go
+ * in front of those of the previous constant.
+ */
+static void add_plan_const(wandder_der_plan_t *plan, uint8_t *bytes,
+        size_t len) {
+
+    wandder_der_plan_op_t *op = NULL;
+    size_t prevlen = 0, needed;
+
+    if (plan->opcount > 0 &&
+            plan->ops[plan->opcount - 1].optype == WANDDER_DER_PLAN_CONST) {
+        op = &(plan->ops[plan->opcount - 1]);
+        prevlen = op->constlen;
+    }
+
+    needed = plan->constlen + len + prevlen;
+    if (needed > plan->constalloced) {
+        plan->constalloced = needed + 256;
+        plan->consts = (uint8_t *)realloc(plan->consts, plan->constalloced);
+        if (plan->consts == NULL) {
+            fprintf(stderr, "Encode error: unable to grow DER plan\n");
+            assert(0);
+        }
+    }
+
+    memcpy(plan->consts + plan->constlen, bytes, len);
+    if (op) {
+        memcpy(plan->consts + plan->constlen + len,
+                plan->consts + op->constoff, prevlen);
+        /* The old copy is simply left behind, plans are built only once */
+    } else {
+        op = new_plan_op(plan, WANDDER_DER_PLAN_CONST);
+    }
+    op->constoff = plan->constlen;
+    op->constlen = len + prevlen;
+    plan->constlen += len + prevlen;
+}
+
+static int encode_plan_node_rev(wandder_der_rev_encoder_t *enc,
+        wandder_der_plan_node_t *node) {
+
+    wandder_der_plan_node_t *child;
+
+    if (node->itemclass == WANDDER_CLASS_ALREADY_ENCODED ||
+            !(node->itemclass & 0x01)) {
+        return wandder_der_rev_encode(enc, node->encodeas, node->itemclass,
+                node->idnum, node->value, node->vallen);
+    }
+
+    if (wandder_der_rev_mark(enc) < 0) {
+        return -1;
+    }
+    for (child = node->lastchild; child; child = child->prevsibling) {
+        if (encode_plan_node_rev(enc, child) < 0) {
+            return -1;
+        }
+    }
+    return wandder_der_rev_wrap(enc, node->itemclass, node->idnum);
+}
+
+static int compile_plan_node(wandder_der_plan_t *plan,
+        wandder_der_rev_encoder_t *scratch, wandder_der_plan_node_t *node) {
+
+    wandder_der_plan_node_t *child;
+    wandder_der_plan_op_t *op;
+    uint8_t *encoded;
+    size_t len;
+
+    if (!node->hasslot && node != plan->root) {
+        wandder_reset_der_rev_encoder(scratch);
+        if (encode_plan_node_rev(scratch, node) < 0) {
+            return -1;
+        }
+        encoded = wandder_der_rev_finish(scratch, &len);
+        if (encoded == NULL) {
+            return -1;
+        }
+        add_plan_const(plan, encoded, len);
+        return 0;
+    }
+
+    if (node->slot >= 0) {
+        op = new_plan_op(plan, WANDDER_DER_PLAN_SLOT);
+        op->encodeas = node->encodeas;
+        op->itemclass = node->itemclass;
+        op->idnum = node->idnum;
+        op->slot = (uint32_t)node->slot;
+        return 0;
+    }
+
+    if (node != plan->root) {
+        new_plan_op(plan, WANDDER_DER_PLAN_MARK);
+    }
+    for (child = node->lastchild; child; child = child->prevsibling) {
+        if (compile_plan_node(plan, scratch, child) < 0) {
+            return -1;
+        }
+    }
+    if (node != plan->root) {
+        op = new_plan_op(plan, WANDDER_DER_PLAN_WRAP);
+        op->itemclass = node->itemclass;
+        op->idnum = node->idnum;
+    }
+    return 0;
+}
+
+/* Turns the recorded structure into the list of operations that is run for
+ * each record. No more fields can be added to the plan after this.
+ */
+int wandder_der_plan_compile(wandder_der_plan_t *plan) {
+
+    wandder_der_rev_encoder_t *scratch;
+    int ret;
+
+    if (plan->compiled) {
+        return 0;
+    }
+
+    if (plan->current != plan->root) {
+        fprintf(stderr, "Encode error: DER plan has unterminated sequences\n");
+        return -1;
+    }
+
+    scratch = wandder_init_der_rev_encoder(512);
+    ret = compile_plan_node(plan, scratch, plan->root);
+    wandder_free_der_rev_encoder(scratch);
+
+    if (ret < 0) {
+        plan->opcount = 0;
+        plan->constlen = 0;
+        return -1;
+    }
+
+    free_plan_nodes(plan->root);
+    plan->root = NULL;
+    plan->current = NULL;
+    plan->compiled = 1;
+    return 0;
+}
+
+/* Encodes one record using a compiled plan. 'values' must hold a value for
+ * every slot in the plan, indexed by slot number.
+ *
+ * Returns a pointer to the encoded record and sets 'len' to its length, or
+ * returns NULL if an error occurs. As with wandder_der_rev_finish(), the
+ * record remains owned by 'enc'.
+ */
+uint8_t *wandder_der_plan_encode(wandder_der_plan_t *plan,
+        wandder_der_rev_encoder_t *enc, wandder_der_plan_value_t *values,
+        size_t *len) {
+
+    wandder_der_plan_op_t *op;
+    wandder_der_plan_value_t *val;
+    uint8_t *ptr;
+    uint32_t i;
+
+    if (!plan->compiled) {
+        fprintf(stderr, "Encode error: DER plan must be compiled before use\n");
+        return NULL;
+    }
+
+    wandder_reset_der_rev_encoder(enc);
+
+    for (i = 0; i < plan->opcount; i++) {
+        op = &(plan->ops[i]);
+
+        switch(op->optype) {
+            case WANDDER_DER_PLAN_CONST:
+                ptr = der_rev_reserve(enc, op->constlen);
+                if (ptr == NULL) {
+                    return NULL;
+                }
+                memcpy(ptr, plan->consts + op->constoff, op->constlen);
+                break;
+            case WANDDER_DER_PLAN_SLOT:
+                val = &(values[op->slot]);
+                if (wandder_der_rev_encode(enc, op->encodeas, op->itemclass,
+                            op->idnum, val->valptr, val->vallen) < 0) {
+                    return NULL;
+                }
+                break;
+            case WANDDER_DER_PLAN_MARK:
+                if (wandder_der_rev_mark(enc) < 0) {
+                    return NULL;
+                }
+                break;
+            case WANDDER_DER_PLAN_WRAP:
+                if (wandder_der_rev_wrap(enc, op->itemclass, op->idnum) < 0) {
+                    return NULL;
+                }
+                break;
+        }
+    }
+
+    return wandder_der_rev_finish(enc, len);
+}
+
 static inline size_t encode_length_indefinite(uint8_t *buf, ptrdiff_t rem) {
     if (rem <= 0) {
         fprintf(stderr, "Encode error: no more space while encoding length\n");
@@ -1129,6 +2032,32 @@ inline size_t encode_here_ber(uint8_t idnum, uint8_t class, uint8_t encodeas,
     return ptr - init_ptr;
 }
 
+/* Encodes only the identifier and length octets for a primitive item
+ * of vallen bytes, so the caller can supply the value from elsewhere
+ * (e.g. as a separate iovec) rather than copying it in.
+ */
+size_t encode_preamble_here_ber(uint8_t idnum, uint8_t class,
+        size_t vallen, uint8_t* ptr, ptrdiff_t rem) {
+
+    uint8_t* init_ptr = ptr;
+    size_t ret;
+
+    ret = encode_identifier(class, idnum, ptr, rem);
+    if (ret == 0) {
+        return 0;
+    }
+    ptr += ret;
+    rem -= ret;
+
+    ret = encode_length(vallen, ptr, rem);
+    if (ret == 0) {
+        return 0;
+    }
+    ptr += ret;
+
+    return ptr - init_ptr;
+}
+
 size_t wandder_encode_inplace_ber(
         uint8_t class, 
         uint8_t idnum, 
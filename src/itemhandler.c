@@ -35,6 +35,88 @@
 #include "itemhandler.h"
 
 
+/* Returns the size of the huge pages used by hugetlbfs, according to
+ * /proc/meminfo. Falls back to 2MB, which is the usual size on x86-64.
+ */
+static size_t get_hugepage_size(void) {
+    FILE *f;
+    char line[128];
+    size_t kb;
+
+    f = fopen("/proc/meminfo", "r");
+    if (f) {
+        while (fgets(line, sizeof(line), f)) {
+            if (sscanf(line, "Hugepagesize: %zu kB", &kb) == 1) {
+                fclose(f);
+                return kb * 1024;
+            }
+        }
+        fclose(f);
+    }
+    return 2 * 1024 * 1024;
+}
+
+static inline bool blob_fits_cap(wandder_itemhandler_t *handler,
+        size_t size) {
+
+    if (handler->memorycap == 0) {
+        return true;
+    }
+    return handler->blobbytes + size <= handler->memorycap;
+}
+
+static inline void *map_blob(wandder_itemhandler_t *handler, size_t rawsize,
+        size_t *upsize) {
+
+    void *mem = MAP_FAILED;
+    int flags = MAP_PRIVATE | MAP_ANONYMOUS;
+
+#ifdef MAP_POPULATE
+    if (handler->prefault) {
+        flags |= MAP_POPULATE;
+    }
+#endif
+
+#ifdef MAP_HUGETLB
+    if (handler->hugepages == WANDDER_ITEMHANDLER_HUGEPAGES_HUGETLB &&
+            rawsize >= handler->hugepagesize) {
+        size_t hugesize = ((rawsize + handler->hugepagesize - 1) /
+                handler->hugepagesize) * handler->hugepagesize;
+
+        if (blob_fits_cap(handler, hugesize)) {
+            /* This fails if the hugetlbfs pool is exhausted, in which
+             * case we just use normal pages instead */
+            mem = mmap(NULL, hugesize, PROT_READ | PROT_WRITE,
+                    flags | MAP_HUGETLB, -1, 0);
+            if (mem != MAP_FAILED) {
+                *upsize = hugesize;
+                return mem;
+            }
+        }
+    }
+#endif
+
+    *upsize = ((rawsize / handler->pagesize) + 1) * handler->pagesize;
+    if (!blob_fits_cap(handler, *upsize)) {
+        return MAP_FAILED;
+    }
+
+    mem = mmap(NULL, *upsize, PROT_READ | PROT_WRITE, flags, -1, 0);
+    if (mem == MAP_FAILED) {
+        fprintf(stderr, "mmap failed: %s\n", strerror(errno));
+        return MAP_FAILED;
+    }
+
+#ifdef MADV_HUGEPAGE
+    if (handler->hugepages != WANDDER_ITEMHANDLER_HUGEPAGES_NONE &&
+            *upsize >= handler->hugepagesize) {
+        /* Only a hint, so we don't care if it fails */
+        madvise(mem, *upsize, MADV_HUGEPAGE);
+    }
+#endif
+    return mem;
+}
+
 static inline wandder_itemblob_t *create_fresh_blob(uint32_t itemcount,
         size_t itemsize, wandder_itemhandler_t *handler) {
 
@@ -42,18 +124,40 @@ static inline wandder_itemblob_t *create_fresh_blob(uint32_t itemcount,
     wandder_itemblob_t *blob;
     size_t upsize;
 
-    upsize = (((itemsize * itemcount) / handler->pagesize) + 1) *
-            handler->pagesize;
     blob = (wandder_itemblob_t *)malloc(sizeof(wandder_itemblob_t));
-    blob->blob = mmap(NULL, upsize, PROT_READ | PROT_WRITE,
-            MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
 
-    if (blob->blob == MAP_FAILED) {
-        fprintf(stderr, "mmap failed: %s\n", strerror(errno));
-        free(blob);
-        return NULL;
+    if (itemsize * itemcount < handler->pagesize) {
+        /* Not worth a whole mapping (and the syscalls to create and
+         * destroy it), just use the heap instead */
+        upsize = itemsize * itemcount;
+        if (!blob_fits_cap(handler, upsize)) {
+            free(blob);
+            return NULL;
+        }
+        blob->blob = malloc(upsize);
+        blob->mmapped = false;
+        if (blob->blob == NULL) {
+            free(blob);
+            return NULL;
+        }
+    } else {
+        blob->blob = map_blob(handler, itemsize * itemcount, &upsize);
+        blob->mmapped = true;
+
+        if (blob->blob == MAP_FAILED) {
+            free(blob);
+            return NULL;
+        }
+
+        if (upsize / itemsize > itemcount && upsize / itemsize <= UINT32_MAX) {
+            /* Huge pages can leave a lot of spare room, so use it */
+            if (upsize - (itemsize * itemcount) > handler->pagesize) {
+                itemcount = upsize / itemsize;
+            }
+        }
     }
 
+    handler->blobbytes += upsize;
     blob->blobsize = upsize;
     blob->itemsize = itemsize;
     blob->alloceditems = itemcount;
@@ -63,27 +167,104 @@ static inline wandder_itemblob_t *create_fresh_blob(uint32_t itemcount,
     return blob;
 }
 
-wandder_itemhandler_t *init_wandder_itemhandler(size_t itemsize,
-        uint32_t itemsperalloc) {
+static inline void free_blob(wandder_itemhandler_t *handler,
+        wandder_itemblob_t *blob) {
+
+    handler->blobbytes -= blob->blobsize;
+    if (blob->mmapped) {
+        munmap(blob->blob, blob->blobsize);
+    } else {
+        free(blob->blob);
+    }
+    free(blob);
+}
+
+void wandder_itemhandler_default_config(wandder_itemhandler_config_t *config,
+        uint32_t initialitems, uint32_t maxitems) {
+
+    memset(config, 0, sizeof(wandder_itemhandler_config_t));
+    config->initialitems = initialitems;
+    config->maxitems = maxitems;
+    config->freelistmax = WANDDER_ITEMHANDLER_DEFAULT_FREELIST;
+    config->memorycap = 0;
+    config->hugepages = WANDDER_ITEMHANDLER_HUGEPAGES_NONE;
+    config->prefault = false;
+}
+
+/* Creates an item handler using the settings in 'config', which should be
+ * initialised using wandder_itemhandler_default_config() first.
+ *
+ * If a memory cap is set, get_wandder_handled_item() will return NULL
+ * whenever another blob would take the handler over that cap.
+ */
+wandder_itemhandler_t *init_wandder_itemhandler_config(size_t itemsize,
+        wandder_itemhandler_config_t *config) {
 
     wandder_itemhandler_t *handler;
+    uint32_t initialitems = config->initialitems;
+    uint32_t maxitems = config->maxitems;
+
+    if (initialitems == 0) {
+        initialitems = 1;
+    }
+    if (maxitems < initialitems) {
+        maxitems = initialitems;
+    }
 
     handler = (wandder_itemhandler_t *)malloc(sizeof(wandder_itemhandler_t));
 
     if (!handler) {
         return NULL;
     }
-    handler->items_per_blob = itemsperalloc;
+    handler->items_per_blob = initialitems;
+    handler->max_items_per_blob = maxitems;
     handler->itemsize = itemsize;
     handler->freelistavail = 0;
     handler->pagesize = sysconf(_SC_PAGE_SIZE);
-    handler->current = create_fresh_blob(itemsperalloc, itemsize, handler);
+    handler->freelistmax = config->freelistmax;
+    handler->memorycap = config->memorycap;
+    handler->blobbytes = 0;
+    handler->hugepages = config->hugepages;
+    handler->prefault = config->prefault;
+    if (handler->hugepages != WANDDER_ITEMHANDLER_HUGEPAGES_NONE) {
+        handler->hugepagesize = get_hugepage_size();
+    } else {
+        handler->hugepagesize = 0;
+    }
+
+    handler->current = create_fresh_blob(initialitems, itemsize, handler);
+    if (handler->current == NULL) {
+        fprintf(stderr, "Unable to allocate initial blob for item handler\n");
+        free(handler);
+        return NULL;
+    }
     handler->freelist = NULL;
     handler->unreleased = 1;
 
     return handler;
 }
 
+/* Creates an item handler whose blobs start out holding 'initialitems'
+ * items and double in size each time a new blob is required, up to a
+ * maximum of 'maxitems' items per blob. Useful for short-lived decoders
+ * that will typically only ever need a handful of items.
+ */
+wandder_itemhandler_t *init_wandder_itemhandler_growable(size_t itemsize,
+        uint32_t initialitems, uint32_t maxitems) {
+
+    wandder_itemhandler_config_t config;
+
+    wandder_itemhandler_default_config(&config, initialitems, maxitems);
+    return init_wandder_itemhandler_config(itemsize, &config);
+}
+
+wandder_itemhandler_t *init_wandder_itemhandler(size_t itemsize,
+        uint32_t itemsperalloc) {
+
+    return init_wandder_itemhandler_growable(itemsize, itemsperalloc,
+            itemsperalloc);
+}
+
 void destroy_wandder_itemhandler(wandder_itemhandler_t *handler) {
     wandder_itemblob_t *blob, *tmp;
 
@@ -91,13 +272,11 @@ void destroy_wandder_itemhandler(wandder_itemhandler_t *handler) {
     while (blob) {
         tmp = blob;
         blob = blob->nextfree;
-        munmap(tmp->blob, tmp->blobsize);
-        free(tmp);
+        free_blob(handler, tmp);
     }
 
     if (handler->current->released >= handler->current->nextavail) {
-        munmap(handler->current->blob, handler->current->blobsize);
-        free(handler->current);
+        free_blob(handler, handler->current);
     }
 
     free(handler);
@@ -118,8 +297,24 @@ uint8_t *get_wandder_handled_item(wandder_itemhandler_t *handler,
             handler->current->nextfree = NULL;
         }
         else if (handler->freelist == NULL) {
-            handler->current = create_fresh_blob(handler->items_per_blob,
-                    handler->itemsize, handler);
+            wandder_itemblob_t *fresh;
+            uint32_t nextitems = handler->items_per_blob;
+
+            if (nextitems < handler->max_items_per_blob) {
+                nextitems *= 2;
+                if (nextitems > handler->max_items_per_blob) {
+                    nextitems = handler->max_items_per_blob;
+                }
+            }
+            fresh = create_fresh_blob(nextitems, handler->itemsize, handler);
+            if (fresh == NULL) {
+                /* Out of memory or at our memory cap -- leave current
+                 * alone so the handler is still usable once items are
+                 * released */
+                return NULL;
+            }
+            handler->items_per_blob = nextitems;
+            handler->current = fresh;
             handler->unreleased ++;
         } else {
             /* Use the first blob on our freelist */
@@ -146,12 +341,12 @@ void release_wandder_handled_item(wandder_itemhandler_t *handler,
 
     itemsource->released ++;
 
-    if (itemsource->released > handler->items_per_blob) {
+    if (itemsource->released > itemsource->alloceditems) {
         return;
     }
 
     if (itemsource != handler->current &&
-            itemsource->released == handler->items_per_blob) {
+            itemsource->released == itemsource->alloceditems) {
         assert(handler->freelist != itemsource);
         itemsource->nextfree = handler->freelist;
         handler->freelist = itemsource;
@@ -159,12 +354,11 @@ void release_wandder_handled_item(wandder_itemhandler_t *handler,
         handler->unreleased --;
     }
 
-    while (handler->freelistavail > 20) {
+    while (handler->freelistavail > (int)handler->freelistmax) {
         wandder_itemblob_t *tmp = handler->freelist;
         handler->freelist = handler->freelist->nextfree;
         handler->freelistavail --;
-        munmap(tmp->blob, tmp->blobsize);
-        free(tmp);
+        free_blob(handler, tmp);
     }
 }
 
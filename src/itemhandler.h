@@ -34,6 +34,10 @@
 
 wandder_itemhandler_t *init_wandder_itemhandler(size_t itemsize,
         uint32_t itemsperalloc);
+wandder_itemhandler_t *init_wandder_itemhandler_growable(size_t itemsize,
+        uint32_t initialitems, uint32_t maxitems);
+wandder_itemhandler_t *init_wandder_itemhandler_config(size_t itemsize,
+        wandder_itemhandler_config_t *config);
 void destroy_wandder_itemhandler(wandder_itemhandler_t *hander);
 uint8_t *get_wandder_handled_item(wandder_itemhandler_t *handler,
         wandder_itemblob_t **itemsource);
@@ -120,6 +120,10 @@ struct wandder_dump_action {
     wandder_dumper_t *descend;
     uint16_t interpretas;
 
+    /* Numeric identifier for 'name', so callers can identify fields
+     * without comparing strings. 0 means no identifier has been assigned.
+     */
+    uint16_t fieldid;
 };
 
 struct wandder_dumper {
@@ -141,18 +145,47 @@ struct wandder_itemblob {
     uint32_t alloceditems;
     uint32_t nextavail;
     uint32_t released;
+    bool mmapped;
 
     wandder_itemblob_t *nextfree;
 };
 
+enum {
+    WANDDER_ITEMHANDLER_HUGEPAGES_NONE = 0,
+    /* Ask for transparent huge pages using madvise() */
+    WANDDER_ITEMHANDLER_HUGEPAGES_THP = 1,
+    /* Map blobs from the hugetlbfs pool, falling back to THP if the pool
+     * cannot satisfy the mapping */
+    WANDDER_ITEMHANDLER_HUGEPAGES_HUGETLB = 2,
+};
+
+#define WANDDER_ITEMHANDLER_DEFAULT_FREELIST 20
+
+typedef struct wandder_itemhandler_config {
+    uint32_t initialitems;  /* Items in the first blob */
+    uint32_t maxitems;      /* Blobs double in size up to this many items */
+    uint32_t freelistmax;   /* Free blobs to keep before unmapping them */
+    size_t memorycap;       /* Maximum bytes of blobs, 0 for no limit */
+    uint8_t hugepages;      /* One of WANDDER_ITEMHANDLER_HUGEPAGES_* */
+    bool prefault;          /* Populate mapped blobs when they are created */
+} wandder_itemhandler_config_t;
+
 typedef struct wandder_itemhandler {
     uint32_t items_per_blob;
+    uint32_t max_items_per_blob;
     size_t itemsize;
     int freelistavail;
     wandder_itemblob_t *current;
     wandder_itemblob_t *freelist;
     uint32_t unreleased;
     size_t pagesize;
+
+    uint32_t freelistmax;
+    size_t memorycap;
+    size_t blobbytes;       /* Total size of all blobs that we own */
+    uint8_t hugepages;
+    size_t hugepagesize;
+    bool prefault;
 } wandder_itemhandler_t;
 
 
@@ -207,8 +240,6 @@ typedef struct wandder_decoder {
     uint32_t sourcelen;
 
     bool ownsource;
-    uint32_t cachedts;
-    char prevgts[16];
 } wandder_decoder_t;
 
 
@@ -245,6 +276,125 @@ typedef struct wandder_found_items {
     wandder_itemblob_t *list_memsrc;
 } wandder_found_t;
 
+/* A query is a search target list that has been "compiled" against a
+ * dumper tree, so that checking whether a decoded item is one of the
+ * targets is a single hash lookup on (parent dumper, item id) rather than
+ * a scan of the entire target array.
+ *
+ * Queries do not hold any per-search state, so a single query can be
+ * executed against any number of decoders (and messages).
+ */
+typedef struct wandder_query_slot {
+    wandder_dumper_t *parent;
+    uint32_t itemid;
+    int targetid;       /* First target with this key, -1 if slot unused */
+} wandder_query_slot_t;
+
+/* For each dumper in the tree, the set of targets that can possibly be
+ * found somewhere beneath it. Used to skip entire subtrees that cannot
+ * contain any of the targets that we have not found yet.
+ */
+typedef struct wandder_query_reach {
+    wandder_dumper_t *dumper;   /* NULL if slot unused */
+    uint64_t targets;           /* Bitmask of target ids */
+} wandder_query_reach_t;
+
+typedef struct wandder_query {
+    wandder_dumper_t *root;
+    wandder_query_slot_t *slots;
+    uint32_t slotmask;
+    int *nexttarget;    /* Chains together targets that share a key */
+    int targetcount;
+
+    wandder_query_reach_t *reach;
+    uint32_t reachmask;
+} wandder_query_t;
+
+#define WANDDER_QUERY_MAX_TARGETS 64
+
+/* A tape is an alternative, flat representation of a decoded message.
+ * Rather than building a tree of wandder_item_t one item at a time, the
+ * whole message is parsed in a single pass into a contiguous array of
+ * entries (in encoded order, i.e. depth-first).
+ *
+ * Each entry records the index of the entry that follows its entire
+ * subtree, so skipping over a constructed field is simply a matter of
+ * jumping to entries[i].next. The first child of a constructed entry
+ * (if it has any children) is always at i + 1.
+ */
+typedef struct wandder_tape_entry {
+    uint32_t identifier;
+    uint32_t offset;        /* Offset of the tag from the start of the tape */
+    uint32_t length;        /* Length of the value (excluding any EOC) */
+    uint32_t next;          /* Index of the next sibling (or the next entry
+                               beyond this subtree, if there is no sibling) */
+    uint16_t level;
+    uint8_t identclass;
+    uint8_t preamblelen;
+    uint8_t indefform;
+} wandder_tape_entry_t;
+
+typedef struct wandder_tape {
+    wandder_tape_entry_t *entries;
+    uint32_t count;
+    uint32_t alloced;
+
+    uint8_t *source;
+    uint32_t sourcelen;     /* Total encoded length of the parsed message */
+} wandder_tape_t;
+
+#define WANDDER_TAPE_MAX_DEPTH 128
+
+/* Describes the location of a single complete message within a larger
+ * buffer, as found by wandder_find_frames().
+ */
+typedef struct wandder_frame {
+    uint32_t offset;
+    uint32_t length;
+} wandder_frame_t;
+
+/* A stream decoder incrementally parses a message onto a tape as its bytes
+ * arrive (e.g. from a TCP socket), keeping its position -- including any
+ * partially received tag or length fields and the stack of open
+ * constructed fields -- between calls. The data given to each call does
+ * not need to remain available afterwards.
+ *
+ * The stream decoder does not keep a copy of the bytes it is fed. Callers
+ * that want the primitive values without reassembling the message can
+ * register a value callback, which is handed each piece of a value as it
+ * arrives.
+ */
+enum {
+    WANDDER_STREAM_ERROR = -1,
+    WANDDER_STREAM_NEED_MORE = 0,
+    WANDDER_STREAM_COMPLETE = 1,
+};
+
+/* Called for each piece of a primitive value. 'entry' is the index of the
+ * value's tape entry, 'valoffset' is the position of 'chunk' within the
+ * value and the entry's length gives the full length of the value.
+ * Return -1 to abort decoding, or 0 to continue.
+ */
+typedef int (*wandder_stream_value_cb)(wandder_tape_t *tape, uint32_t entry,
+        uint8_t *chunk, uint32_t chunklen, uint32_t valoffset, void *cbdata);
+
+typedef struct wandder_stream_decoder {
+    wandder_tape_t *tape;
+    uint32_t consumed;      /* Bytes of the current message seen so far */
+    uint8_t complete;
+
+    uint32_t open[WANDDER_TAPE_MAX_DEPTH];
+    int depth;
+
+    uint8_t hdr[16];        /* Partially received tag / length bytes */
+    uint8_t hdrlen;
+    uint64_t contentrem;    /* Primitive value bytes still to be skipped */
+    uint32_t valueentry;    /* Tape entry for the value being skipped */
+
+    wandder_stream_value_cb valuecb;
+    void *cbdata;
+} wandder_stream_decoder_t;
+
 
 /* Encoding is performed left to right, but the length values for each field
  * are calculated from inside outwards. Therefore, fields to be encoded are
@@ -309,6 +459,26 @@ struct wandder_encoded_result_ber {
     size_t len;
 };
 
+/* Encoded results are pooled by size class. The smallest class holds up to
+ * WANDDER_RESULT_MIN_CLASS_SIZE bytes and each class is twice the size of
+ * the one before. Results that are too big for the largest class are
+ * allocated to fit and are freed rather than pooled when released.
+ */
+#define WANDDER_RESULT_SIZE_CLASSES 8
+#define WANDDER_RESULT_MIN_CLASS_SIZE 512
+
+/* Released results are only counted as pooled once the encoding thread has
+ * collected them from the return list.
+ */
+typedef struct wandder_encoded_result_stats {
+    uint64_t reused;
+    uint64_t allocated;
+    uint64_t oversized;     /* Allocations bigger than the largest class */
+    uint64_t discarded;     /* Freed on release (oversized or pool full) */
+    uint64_t pooledbytes;   /* Buffer space held by idle pooled results */
+    uint32_t pooled[WANDDER_RESULT_SIZE_CLASSES];
+} wandder_encoded_result_stats_t;
+
 /* The encoder manages the overall encoder process. It simply maintains the
  * full hierarchy of pending items and will encode them all once the user
  * indicates that all fields have been pushed to the encoder.
@@ -324,12 +494,96 @@ struct wandder_encoder {
     wandder_pend_t *quickfree_pc_tail;
     wandder_pend_t *freelist;
     wandder_pend_t *freeprecompute;
-    wandder_encoded_result_t *freeresults;
 
-    pthread_mutex_t mutex;
+    /* Results that are ready to be reused, one list per size class. Only
+     * ever touched by the thread that is doing the encoding.
+     */
+    wandder_encoded_result_t *freeresults[WANDDER_RESULT_SIZE_CLASSES];
+
+    /* Results that have been released by other threads. Releasing pushes
+     * onto this list without locking; the encoding thread takes the whole
+     * list in one go and sorts it into freeresults when a class runs dry.
+     */
+    wandder_encoded_result_t *returnedresults;
+
+    /* Maximum bytes of idle results to keep pooled, 0 for no limit */
+    uint64_t resultpoolcap;
+    wandder_encoded_result_stats_t resultstats;
 };
 
 
+/* The reverse DER encoder writes an encoding from back to front into a
+ * single buffer. Because the contents of a constructed field are always
+ * written before its header, the length is already known by the time the
+ * header is written -- so there is no need to stage pending fields or to
+ * make a second pass over them.
+ *
+ * Fields must be pushed in reverse order, i.e. the last child of a sequence
+ * first. To encode a constructed field, call wandder_der_rev_mark() before
+ * writing its (reversed) children and wandder_der_rev_wrap() afterwards.
+ */
+#define WANDDER_DER_REV_MAX_DEPTH 32
+
+typedef struct wandder_der_rev_encoder {
+    uint8_t *buf;
+    size_t alloced;
+    size_t used;        /* Bytes written so far, counted from the end */
+    uint32_t depth;
+    size_t marks[WANDDER_DER_REV_MAX_DEPTH];
+} wandder_der_rev_encoder_t;
+
+
+/* An encode plan records a DER structure with a fixed shape once, where
+ * some of the leaves are placeholders ("slots") whose values are supplied
+ * separately for each record. Compiling the plan encodes every subtree
+ * that contains no slots ahead of time, so encoding a record only has to
+ * encode the slot values and the headers of the constructed fields that
+ * enclose them.
+ */
+enum {
+    WANDDER_DER_PLAN_CONST = 0,     /* Copy pre-encoded bytes */
+    WANDDER_DER_PLAN_SLOT = 1,      /* Encode a placeholder value */
+    WANDDER_DER_PLAN_MARK = 2,      /* End of a constructed field's contents */
+    WANDDER_DER_PLAN_WRAP = 3,      /* Header of a constructed field */
+};
+
+typedef struct wandder_der_plan_op {
+    uint8_t optype;
+    uint8_t encodeas;
+    uint8_t itemclass;
+    uint32_t idnum;
+    uint32_t slot;
+    size_t constoff;
+    size_t constlen;
+} wandder_der_plan_op_t;
+
+typedef struct wandder_der_plan_value {
+    void *valptr;
+    uint32_t vallen;
+} wandder_der_plan_value_t;
+
+typedef struct wandder_der_plan_node wandder_der_plan_node_t;
+
+typedef struct wandder_der_plan {
+    /* Only used while the plan is being recorded */
+    wandder_der_plan_node_t *root;
+    wandder_der_plan_node_t *current;
+
+    uint32_t slotcount;
+    uint8_t compiled;
+
+    /* Operations are stored in the order they are executed, i.e. back
+     * to front for the reverse DER encoder.
+     */
+    wandder_der_plan_op_t *ops;
+    uint32_t opcount;
+    uint32_t opalloced;
+    uint8_t *consts;
+    size_t constlen;
+    size_t constalloced;
+} wandder_der_plan_t;
+
+
 /* Encoding API
  * ----------------------------------------------------
  */
@@ -383,12 +637,47 @@ void wandder_release_encoded_result(wandder_encoder_t *enc,
         wandder_encoded_result_t *res);
 void wandder_release_encoded_results(wandder_encoder_t *enc,
         wandder_encoded_result_t *res, wandder_encoded_result_t *tail);
+void wandder_set_encoded_result_pool_cap(wandder_encoder_t *enc,
+        uint64_t maxbytes);                                                 //0 means no limit
+void wandder_get_encoded_result_stats(wandder_encoder_t *enc,
+        wandder_encoded_result_stats_t *stats);                             //call from the encoding thread
+
+//reverse DER encoder -- see wandder_der_rev_encoder_t above
+wandder_der_rev_encoder_t *wandder_init_der_rev_encoder(size_t init_alloc);
+void wandder_reset_der_rev_encoder(wandder_der_rev_encoder_t *enc);
+void wandder_free_der_rev_encoder(wandder_der_rev_encoder_t *enc);
+int wandder_der_rev_encode(wandder_der_rev_encoder_t *enc, uint8_t encodeas,
+        uint8_t itemclass, uint32_t idnum, void *valptr, uint32_t vallen);
+int wandder_der_rev_mark(wandder_der_rev_encoder_t *enc);                  //start the contents of a constructed field
+int wandder_der_rev_wrap(wandder_der_rev_encoder_t *enc, uint8_t itemclass,
+        uint32_t idnum);                                                    //write the header for the last marked field
+uint8_t *wandder_der_rev_finish(wandder_der_rev_encoder_t *enc, size_t *len);
+
+//DER encode plans -- see wandder_der_plan_t above
+wandder_der_plan_t *wandder_create_der_plan(void);
+void wandder_free_der_plan(wandder_der_plan_t *plan);
+int wandder_der_plan_add(wandder_der_plan_t *plan, uint8_t encodeas,
+        uint8_t itemclass, uint32_t idnum, void *valptr, uint32_t vallen);  //add a constant field, or open a sequence/set
+int wandder_der_plan_add_slot(wandder_der_plan_t *plan, uint8_t encodeas,
+        uint8_t itemclass, uint32_t idnum);                                 //add a placeholder, returns its slot number
+int wandder_der_plan_endseq(wandder_der_plan_t *plan);
+int wandder_der_plan_compile(wandder_der_plan_t *plan);
+uint8_t *wandder_der_plan_encode(wandder_der_plan_t *plan,
+        wandder_der_rev_encoder_t *enc, wandder_der_plan_value_t *values,
+        size_t *len);                                                       //values are indexed by slot number
 
 /* Decoding API
  * ----------------------------------------------------
  */
 wandder_decoder_t *init_wandder_decoder(wandder_decoder_t *dec,
         uint8_t *source, uint32_t len, bool copy);
+wandder_decoder_t *init_wandder_decoder_small(wandder_decoder_t *dec,
+        uint8_t *source, uint32_t len, bool copy);
+void wandder_itemhandler_default_config(wandder_itemhandler_config_t *config,
+        uint32_t initialitems, uint32_t maxitems);
+wandder_decoder_t *init_wandder_decoder_config(wandder_decoder_t *dec,
+        uint8_t *source, uint32_t len, bool copy,
+        wandder_itemhandler_config_t *config);                              //config is only used when creating a new decoder
 void wandder_reset_decoder(wandder_decoder_t *dec);
 void free_wandder_decoder(wandder_decoder_t *dec);
 int wandder_decode_next(wandder_decoder_t *dec);
@@ -420,6 +709,43 @@ int wandder_search_items(wandder_decoder_t *dec, uint16_t level,
         wandder_dumper_t *actions, wandder_target_t *targets,
         int targetcount, wandder_found_t **found, int stopthresh);
 void wandder_free_found(wandder_found_t *found);
+wandder_query_t *wandder_compile_query(wandder_dumper_t *root,
+        wandder_target_t *targets, int targetcount);
+void wandder_free_query(wandder_query_t *query);
+int wandder_execute_query(wandder_decoder_t *dec, wandder_query_t *query,
+        wandder_found_t **found, int stopthresh);
+
+/* Tape decoding API
+ * ----------------------------------------------------
+ */
+wandder_tape_t *wandder_create_tape(uint32_t initialentries);
+void wandder_free_tape(wandder_tape_t *tape);
+int64_t wandder_tape_parse(wandder_tape_t *tape, uint8_t *source,
+        uint32_t len);
+uint8_t *wandder_tape_get_itemptr(wandder_tape_t *tape, uint32_t index);
+int64_t wandder_tape_get_integer_value(wandder_tape_t *tape, uint32_t index);
+int64_t wandder_tape_find_child(wandder_tape_t *tape, uint32_t parent,
+        uint32_t ident);
+int64_t wandder_tape_find_path(wandder_tape_t *tape, uint32_t start,
+        uint32_t *idents, int identcount);
+
+/* Framing API
+ * ----------------------------------------------------
+ */
+int64_t wandder_get_message_length(uint8_t *buf, uint32_t len);
+int wandder_find_frames(uint8_t *buf, uint32_t len, wandder_frame_t *frames,
+        int maxframes, uint32_t *consumed);
+
+/* Streaming decoding API
+ * ----------------------------------------------------
+ */
+wandder_stream_decoder_t *wandder_create_stream_decoder(void);
+void wandder_reset_stream_decoder(wandder_stream_decoder_t *sdec);
+void wandder_free_stream_decoder(wandder_stream_decoder_t *sdec);
+void wandder_stream_set_value_callback(wandder_stream_decoder_t *sdec,
+        wandder_stream_value_cb cb, void *cbdata);
+int wandder_stream_feed(wandder_stream_decoder_t *sdec, uint8_t *data,
+        uint32_t len, uint32_t *used);
 #endif
 
 
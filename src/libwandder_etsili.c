@@ -35,6 +35,7 @@
 #include <time.h>
 #include <assert.h>
 #include <math.h>
+#include <pthread.h>
 #include "wandder_internal.h"
 #include "libwandder_etsili.h"
 
@@ -69,8 +70,8 @@ const uint8_t wandder_etsi_epsirioid[9] =
 const uint8_t wandder_etsi_epsccoid[9] =
         {0x00, 0x04, 0x00, 0x02, 0x02, 0x04, 0x09, 0x11, 0x00};
 
-static void init_dumpers(wandder_etsispec_t *dec);
-static void free_dumpers(wandder_etsispec_t *dec);
+static void init_dumpers(wandder_etsi_dumpers_t *dec);
+static void free_dumpers(wandder_etsi_dumpers_t *dec);
 static char *interpret_enum(wandder_etsispec_t *etsidec, wandder_item_t *item,
         wandder_dumper_t *curr, char *valstr, int len);
 static const char *stringify_ipaddress(wandder_etsispec_t *etsidec,
@@ -105,6 +106,10 @@ static char *stringify_eps_ambr(wandder_etsispec_t *etsidec,
         wandder_item_t *item, wandder_dumper_t *curr, char *valstr, int len);
 static char *decrypt_encrypted_payload_item(wandder_etsispec_t *etsidec,
         wandder_item_t *item, char *valstr, int len);
+static int decrypt_payload_item(wandder_etsispec_t *etsidec,
+        wandder_item_t *item);
+static uint8_t *internal_get_cc_contents(wandder_etsispec_t *etsidec,
+        wandder_decoder_t *dec, uint32_t *len, char *name, int namelen);
 static char *stringify_sequenced_primitives(char *sequence_name,
         wandder_decoder_t *dec, char *space, int spacelen, int interpretas);
 
@@ -257,11 +262,106 @@ static void wandder_etsili_free_stack(wandder_etsi_stack_t *stack) {
     free(stack);
 }
 
+/* The targets used to find CC contents -- the encrypted payload target
+ * must be last, as it is omitted when searching decrypted payloads or
+ * decoders other than the main one.
+ */
+static void compile_queries(wandder_etsi_dumpers_t *dumpers) {
+
+    wandder_target_t cctgts[6];
+    wandder_target_t iritgts[4];
+
+    /* Find IPCCContents or IPMMCCContents or UMTSCC or emailCC or epsCC */
+    cctgts[0].parent = &dumpers->ipcccontents;
+    cctgts[0].itemid = 0;
+    cctgts[1].parent = &dumpers->ipmmcc;
+    cctgts[1].itemid = 1;
+    cctgts[2].parent = &dumpers->cccontents;
+    cctgts[2].itemid = 4;
+    cctgts[3].parent = &dumpers->emailcc;
+    cctgts[3].itemid = 2;
+    cctgts[4].parent = &dumpers->epscc;
+    cctgts[4].itemid = 2;
+    /* Encrypted payload */
+    cctgts[5].parent = &dumpers->payload;
+    cctgts[5].itemid = 4;
+
+    dumpers->cc_query = wandder_compile_query(&(dumpers->root), cctgts, 6);
+    dumpers->cc_query_noencrypt = wandder_compile_query(&(dumpers->root),
+            cctgts, 5);
+    dumpers->cc_query_decrypted = wandder_compile_query(
+            &(dumpers->encryptedpayloadroot), cctgts, 5);
+
+    /* originalIPMMMessage */
+    iritgts[0].parent = &dumpers->ipmmiricontents;
+    iritgts[0].itemid = 0;
+    /* sIPContents */
+    iritgts[1].parent = &dumpers->sipmessage;
+    iritgts[1].itemid = 2;
+    /* rawAAAData */
+    iritgts[2].parent = &dumpers->ipiricontents;
+    iritgts[2].itemid = 15;
+    /* encryptedContainer */
+    iritgts[3].parent = &dumpers->payload;
+    iritgts[3].itemid = 4;
+
+    /* TODO H323 contents... */
+
+    dumpers->iri_query = wandder_compile_query(&(dumpers->root), iritgts, 4);
+    dumpers->iri_query_decrypted = wandder_compile_query(
+            &(dumpers->encryptedpayloadroot), iritgts, 3);
+}
+
+static void free_queries(wandder_etsi_dumpers_t *dumpers) {
+    wandder_free_query(dumpers->cc_query);
+    wandder_free_query(dumpers->cc_query_noencrypt);
+    wandder_free_query(dumpers->cc_query_decrypted);
+    wandder_free_query(dumpers->iri_query);
+    wandder_free_query(dumpers->iri_query_decrypted);
+}
+
+/* The dumpers are shared by all ETSI decoders and are only freed once
+ * the last decoder using them has been freed.
+ */
+static wandder_etsi_dumpers_t *shared_dumpers = NULL;
+static int shared_dumpers_refs = 0;
+static pthread_mutex_t shared_dumpers_mutex = PTHREAD_MUTEX_INITIALIZER;
+
+static wandder_etsi_dumpers_t *acquire_dumpers(void) {
+
+    wandder_etsi_dumpers_t *dumpers;
+
+    pthread_mutex_lock(&shared_dumpers_mutex);
+    if (shared_dumpers == NULL) {
+        shared_dumpers = (wandder_etsi_dumpers_t *)calloc(1,
+                sizeof(wandder_etsi_dumpers_t));
+        init_dumpers(shared_dumpers);
+        compile_queries(shared_dumpers);
+    }
+    shared_dumpers_refs ++;
+    dumpers = shared_dumpers;
+    pthread_mutex_unlock(&shared_dumpers_mutex);
+    return dumpers;
+}
+
+static void release_dumpers(void) {
+
+    pthread_mutex_lock(&shared_dumpers_mutex);
+    shared_dumpers_refs --;
+    if (shared_dumpers_refs == 0 && shared_dumpers != NULL) {
+        free_queries(shared_dumpers);
+        free_dumpers(shared_dumpers);
+        free(shared_dumpers);
+        shared_dumpers = NULL;
+    }
+    pthread_mutex_unlock(&shared_dumpers_mutex);
+}
+
 wandder_etsispec_t *wandder_create_etsili_decoder(void) {
     wandder_etsispec_t *etsidec = (wandder_etsispec_t *)calloc(1,
             sizeof(wandder_etsispec_t));
 
-    init_dumpers(etsidec);
+    etsidec->dumpers = acquire_dumpers();
 
     etsidec->stack = NULL;
     etsidec->decstate = 0;
@@ -275,7 +375,16 @@ wandder_etsispec_t *wandder_create_etsili_decoder(void) {
     etsidec->saved_decrypted_payload = NULL;
     etsidec->saved_payload_size = 0;
     etsidec->saved_payload_name = NULL;
+    etsidec->saved_payload_fieldid = WANDDER_ETSILI_FIELD_UNKNOWN;
     etsidec->decryption_key = NULL;
+    etsidec->decryption_key_ready = 0;
+    etsidec->decryption_env_checked = 0;
+    etsidec->cipherctx = NULL;
+    etsidec->decrypt_buf = NULL;
+    etsidec->decrypt_buf_alloced = 0;
+    etsidec->hdrtape = NULL;
+    etsidec->batch_buf = NULL;
+    etsidec->batch_buf_alloced = 0;
 
     return etsidec;
 }
@@ -284,6 +393,22 @@ uint8_t wandder_etsili_get_cc_format(wandder_etsispec_t *etsidec) {
     return etsidec->ccformat;
 }
 
+static inline uint8_t ipmmcc_frame_type_to_format(int64_t frametype) {
+    switch(frametype) {
+        case 0:
+            return WANDDER_ETSILI_CC_FORMAT_IP;
+        case 1:
+            return WANDDER_ETSILI_CC_FORMAT_UDP;
+        case 2:
+        case 5:
+            return WANDDER_ETSILI_CC_FORMAT_RTP;
+        case 4:
+            return WANDDER_ETSILI_CC_FORMAT_TCP;
+        /* TODO one day we might care about MSRP or UDPTL */
+    }
+    return WANDDER_ETSILI_CC_FORMAT_UNKNOWN;
+}
+
 static uint8_t wandder_etsili_get_ipmmcc_format(wandder_etsispec_t *etsidec,
         wandder_decoder_t *dec, wandder_dumper_t *startpoint) {
     wandder_found_t *found = NULL;
@@ -304,7 +429,7 @@ static uint8_t wandder_etsili_get_ipmmcc_format(wandder_etsispec_t *etsidec,
     }
 
     wandder_reset_decoder(dec);
-    tgt.parent = &etsidec->ipmmcc;
+    tgt.parent = &etsidec->dumpers->ipmmcc;
     tgt.itemid = 2;
     tgt.found = false;
 
@@ -316,25 +441,7 @@ static uint8_t wandder_etsili_get_ipmmcc_format(wandder_etsispec_t *etsidec,
         vp = found->list[0].item->valptr;
         if (found->list[0].targetid == 0) {
             val = wandder_decode_integer_value(vp, len);
-            switch(val) {
-                case 0:
-                    etsidec->ccformat = WANDDER_ETSILI_CC_FORMAT_IP;
-                    break;
-                case 1:
-                    etsidec->ccformat = WANDDER_ETSILI_CC_FORMAT_UDP;
-                    break;
-                case 2:
-                case 5:
-                    etsidec->ccformat = WANDDER_ETSILI_CC_FORMAT_RTP;
-                    break;
-                case 4:
-                    etsidec->ccformat = WANDDER_ETSILI_CC_FORMAT_TCP;
-                    break;
-                /* TODO one day we might care about MSRP or UDPTL */
-                default:
-                    etsidec->ccformat = WANDDER_ETSILI_CC_FORMAT_UNKNOWN;
-            }
-
+            etsidec->ccformat = ipmmcc_frame_type_to_format(val);
         }
         wandder_free_found(found);
     }
@@ -363,7 +470,7 @@ static uint8_t wandder_etsili_get_email_format(wandder_etsispec_t *etsidec,
 
     /* Find the email-Format field in the encoded record, if present */
     wandder_reset_decoder(dec);
-    tgt.parent = &etsidec->emailcc;
+    tgt.parent = &etsidec->dumpers->emailcc;
     tgt.itemid = 1;
     tgt.found = false;
 
@@ -392,7 +499,7 @@ void wandder_free_etsili_decoder(wandder_etsispec_t *etsidec) {
         return;
     }
 
-    free_dumpers(etsidec);
+    release_dumpers();
 
     if (etsidec->stack) {
         wandder_etsili_free_stack(etsidec->stack);
@@ -409,8 +516,17 @@ void wandder_free_etsili_decoder(wandder_etsispec_t *etsidec) {
     if (etsidec->saved_decrypted_payload) {
         free(etsidec->saved_decrypted_payload);
     }
-    if (etsidec->decrypted) {
-        free(etsidec->decrypted);
+    if (etsidec->decrypt_buf) {
+        free(etsidec->decrypt_buf);
+    }
+    if (etsidec->cipherctx) {
+        EVP_CIPHER_CTX_free((EVP_CIPHER_CTX *)etsidec->cipherctx);
+    }
+    if (etsidec->hdrtape) {
+        wandder_free_tape(etsidec->hdrtape);
+    }
+    if (etsidec->batch_buf) {
+        free(etsidec->batch_buf);
     }
     if (etsidec->decryption_key) {
         free(etsidec->decryption_key);
@@ -426,7 +542,7 @@ void wandder_attach_etsili_buffer(wandder_etsispec_t *etsidec,
 }
 
 wandder_dumper_t *wandder_get_etsili_structure(wandder_etsispec_t *etsidec) {
-    return &(etsidec->root);
+    return &(etsidec->dumpers->root);
 }
 
 struct timeval wandder_etsili_get_header_timestamp(wandder_etsispec_t *etsidec) 
@@ -481,6 +597,8 @@ struct timeval wandder_etsili_get_header_timestamp(wandder_etsispec_t *etsidec)
 uint32_t wandder_etsili_get_pdu_length(wandder_etsispec_t *etsidec) {
 
     int ret;
+    int64_t msglen;
+    wandder_decoder_t *dec = etsidec->dec;
 
     if (etsidec->decstate == 0) {
         fprintf(stderr, "No buffer attached to this decoder -- please call"
@@ -489,25 +607,32 @@ uint32_t wandder_etsili_get_pdu_length(wandder_etsispec_t *etsidec) {
     }
     /* Easy, reset the decoder then grab the length of the first element 
     (provided it is not indefinite)*/
-    wandder_reset_decoder(etsidec->dec);
+    wandder_reset_decoder(dec);
 
-    ret = wandder_decode_next(etsidec->dec);
+    ret = wandder_decode_next(dec);
     if (ret <= 0) {
         return ret;
     }
 
-    int preamble = etsidec->dec->current->preamblelen;
-    int trailing = etsidec->dec->current->trailing;
-
     /* Don't forget to include the preamble length so the caller can skip
-     * over the entire PDU if desired.
+     * over the entire PDU if desired. This works even if only the start
+     * of the PDU is in the buffer, so callers can use it to size their
+     * next read.
      */
-    if (etsidec->dec->current->indefform){
-        return wandder_decode_skip(etsidec->dec);
+    if (!dec->current->indefform) {
+        return wandder_get_itemlen(dec) + dec->current->preamblelen +
+                dec->current->trailing;
     }
-    else {
-        return wandder_get_itemlen(etsidec->dec) + preamble + trailing;
+
+    /* For indefinite length PDUs, we only need to walk the tags and
+     * lengths to find the end-of-contents -- no need to decode each
+     * individual item.
+     */
+    msglen = wandder_get_message_length(dec->source, dec->sourcelen);
+    if (msglen <= 0) {
+        return 0;
     }
+    return (uint32_t)msglen;
 }
 
 int wandder_set_etsili_decryption_key(wandder_etsispec_t *etsidec, char *key) {
@@ -516,9 +641,75 @@ int wandder_set_etsili_decryption_key(wandder_etsispec_t *etsidec, char *key) {
         free(etsidec->decryption_key);
     }
     etsidec->decryption_key = strdup(key);
+
+    /* Force the new key to be converted and loaded into the cipher
+     * context next time we need it */
+    etsidec->decryption_key_ready = 0;
+    return 1;
+}
+
+/* Converts the hex decryption key into binary, if we haven't already.
+ * If no key has been set explicitly, we fall back to the
+ * LIBWANDDER_ETSILI_DECRYPTION_KEY environment variable (which is only
+ * checked the first time a key is required).
+ *
+ * Returns 1 if a key is ready for use, 0 if no key is available.
+ */
+static int load_decryption_key(wandder_etsispec_t *etsidec) {
+
+    char *keyhex;
+    size_t hexlen;
+
+    if (etsidec->decryption_key_ready) {
+        return 1;
+    }
+
+    keyhex = etsidec->decryption_key;
+    if (keyhex == NULL) {
+        if (etsidec->decryption_env_checked) {
+            return 0;
+        }
+        etsidec->decryption_env_checked = 1;
+        keyhex = getenv("LIBWANDDER_ETSILI_DECRYPTION_KEY");
+        if (keyhex == NULL) {
+            return 0;
+        }
+    }
+
+    hexlen = strlen(keyhex);
+    if (hexlen > sizeof(etsidec->decryption_key_bin) * 2) {
+        hexlen = sizeof(etsidec->decryption_key_bin) * 2;
+    }
+    memset(etsidec->decryption_key_bin, 0,
+            sizeof(etsidec->decryption_key_bin));
+    hex2bin(keyhex, etsidec->decryption_key_bin, hexlen);
+
+    /* Any existing context was keyed using the old key */
+    if (etsidec->cipherctx) {
+        EVP_CIPHER_CTX_free((EVP_CIPHER_CTX *)etsidec->cipherctx);
+        etsidec->cipherctx = NULL;
+    }
+    etsidec->decryption_key_ready = 1;
     return 1;
 }
 
+/* Returns a buffer of at least 'len' bytes for writing decrypted content
+ * into. The same buffer is re-used for each encrypted PDU.
+ */
+static uint8_t *get_decrypt_buffer(wandder_etsispec_t *etsidec,
+        uint32_t len) {
+
+    if (etsidec->decrypt_buf_alloced < len) {
+        if (etsidec->decrypt_buf) {
+            free(etsidec->decrypt_buf);
+        }
+        /* Round up to avoid lots of small reallocations */
+        etsidec->decrypt_buf_alloced = ((len / 1024) + 1) * 1024;
+        etsidec->decrypt_buf = malloc(etsidec->decrypt_buf_alloced);
+    }
+    return etsidec->decrypt_buf;
+}
+
 static inline void push_stack(wandder_etsi_stack_t *stack,
         wandder_dumper_t *next) {
 
@@ -541,20 +732,19 @@ static inline void push_stack(wandder_etsi_stack_t *stack,
 /* Most of the code for this function is derived from example code provided
  * by Pim van Stam.
  */
-static int decrypt_payload_content_aes_192_cbc(uint8_t *ciphertext,
-        int ciphertext_len,
-        char *key_hex, int32_t seqno, unsigned char *plainspace, int plainlen) {
+static int decrypt_payload_content_aes_192_cbc(wandder_etsispec_t *etsidec,
+        uint8_t *ciphertext, int ciphertext_len, int32_t seqno,
+        unsigned char *plainspace) {
 
     EVP_CIPHER_CTX *ctx;
     int32_t swap_seqno = htonl(seqno);
     uint8_t iv[16];
-    int i, key_hex_size;
-    uint8_t *key_bin;
+    int i;
     int finallen = 0, interimlen = 0;
 
     assert(sizeof(int32_t) == 4);
 
-    if (key_hex == NULL) {
+    if (!load_decryption_key(etsidec)) {
         fprintf(stderr, "Unable to decrypt payload content as no encryption key has been provided.\nUse LIBWANDDER_ETSILI_DECRYPTION_KEY environment variable or\nwandder_set_etsili_decryption_key() function to provide the key.\n");
         return -1;
     }
@@ -563,29 +753,38 @@ static int decrypt_payload_content_aes_192_cbc(uint8_t *ciphertext,
         memcpy(&(iv[i * sizeof(int32_t)]), &swap_seqno, sizeof(int32_t));
     }
 
-    key_hex_size = strlen(key_hex);
-    key_bin = calloc(1, key_hex_size);     // twice as much as we need
+    ctx = (EVP_CIPHER_CTX *)etsidec->cipherctx;
+    if (ctx == NULL) {
+        /* Set up the key schedule once, then only the IV needs to
+         * change for each subsequent PDU */
+        ctx = EVP_CIPHER_CTX_new();
+        if (ctx == NULL) {
+            fprintf(stderr, "Unable to create EVP context for decryption: %s\n",
+                    strerror(errno));
+            return -1;
+        }
 
-    hex2bin(key_hex, key_bin, key_hex_size);
+        if (EVP_DecryptInit_ex(ctx, EVP_aes_192_cbc(), NULL,
+                    etsidec->decryption_key_bin, NULL) != 1) {
+            fprintf(stderr, "Unable to initialise EVP context for decryption: %s\n",
+                    strerror(errno));
+            EVP_CIPHER_CTX_free(ctx);
+            return -1;
+        }
 
-    ctx = EVP_CIPHER_CTX_new();
-    if (ctx == NULL) {
-        fprintf(stderr, "Unable to create EVP context for decryption: %s\n",
-                strerror(errno));
-        return -1;
+        /* Disable padding because the ciphertext should already be a
+         * multiple of the block size.
+         */
+        EVP_CIPHER_CTX_set_padding(ctx, 0);
+        etsidec->cipherctx = ctx;
     }
 
-    if (EVP_DecryptInit_ex(ctx, EVP_aes_192_cbc(), NULL, key_bin, iv) != 1) {
-        fprintf(stderr, "Unable to initialise EVP context for decryption: %s\n",
+    if (EVP_DecryptInit_ex(ctx, NULL, NULL, NULL, iv) != 1) {
+        fprintf(stderr, "Unable to set IV for decryption: %s\n",
                 strerror(errno));
         return -1;
     }
 
-    /* Disable padding because the ciphertext should already be a multiple
-     * of the block size.
-     */
-    EVP_CIPHER_CTX_set_padding(ctx, 0);
-
     if (EVP_DecryptUpdate(ctx, plainspace, &interimlen, ciphertext,
             ciphertext_len) != 1) {
         fprintf(stderr, "Error while decrypting CC payload content: %s\n",
@@ -601,9 +800,6 @@ static int decrypt_payload_content_aes_192_cbc(uint8_t *ciphertext,
     }
 
     finallen += interimlen;
-    EVP_CIPHER_CTX_free(ctx);
-    free(key_bin);
-
     return finallen;
 }
 
@@ -634,7 +830,7 @@ static char *decode_field_to_str(wandder_etsispec_t *etsidec,
             ident = wandder_get_identifier(dec);
             (etsidec->stack->atthislevel[stack->current])++;
 
-            if (curr == &(etsidec->emailcc) && ident == 1) {
+            if (curr == &(etsidec->dumpers->emailcc) && ident == 1) {
                 int64_t val;
                 val = wandder_get_integer_value(dec->current, NULL);
                 if (val <= 255) {
@@ -647,6 +843,8 @@ static char *decode_field_to_str(wandder_etsispec_t *etsidec,
                     /* cache the decrypted payload content */
                     etsidec->saved_payload_size = dec->current->length;
                     etsidec->saved_payload_name = curr->members[ident].name;
+                    etsidec->saved_payload_fieldid =
+                            curr->members[ident].fieldid;
                     if (etsidec->saved_decrypted_payload) {
                         free(etsidec->saved_decrypted_payload);
                     }
@@ -662,13 +860,10 @@ static char *decode_field_to_str(wandder_etsispec_t *etsidec,
                 /* If we are an IP CC we can stop, but IPMM CCs have to
                  * keep going in case the optional fields are present :(
                  */
-                if (strcmp(curr->members[ident].name, "iPPackets") == 0) {
-                    return NULL;
-                }
-                if (strcmp(curr->members[ident].name, "uMTSCC") == 0) {
-                    return NULL;
-                }
-                if (strcmp(curr->members[ident].name, "content") == 0) {
+                if (curr->members[ident].fieldid ==
+                        WANDDER_ETSILI_FIELD_iPPackets ||
+                        curr->members[ident].fieldid ==
+                        WANDDER_ETSILI_FIELD_uMTSCC) {
                     return NULL;
                 }
                 return wandder_etsili_get_next_fieldstr(etsidec, space,
@@ -916,7 +1111,7 @@ char *wandder_etsili_get_next_fieldstr(wandder_etsispec_t *etsidec, char *space,
         etsidec->stack->atthislevel = (int *)malloc(sizeof(int *) * 10);
 
         etsidec->stack->alloced = 10;
-        etsidec->stack->stk[0] = &etsidec->root;
+        etsidec->stack->stk[0] = &etsidec->dumpers->root;
         etsidec->stack->current = 0;
         etsidec->stack->atthislevel[0] = 0;
     }
@@ -930,7 +1125,7 @@ char *wandder_etsili_get_next_fieldstr(wandder_etsispec_t *etsidec, char *space,
             etsidec->decrypt_stack->atthislevel = (int *)malloc(sizeof(int *) * 10);
 
             etsidec->decrypt_stack->alloced = 10;
-            etsidec->decrypt_stack->stk[0] = &etsidec->encryptedpayloadroot;
+            etsidec->decrypt_stack->stk[0] = &etsidec->dumpers->encryptedpayloadroot;
             etsidec->decrypt_stack->current = 0;
             etsidec->decrypt_stack->atthislevel[0] = 0;
         }
@@ -939,7 +1134,6 @@ char *wandder_etsili_get_next_fieldstr(wandder_etsispec_t *etsidec, char *space,
                 etsidec->decrypt_stack, space, spacelen) == NULL) {
 
             /* we either failed or we ran out of decrypted content... */
-            free(etsidec->decrypted);
             etsidec->decrypted = NULL;
             return wandder_etsili_get_next_fieldstr(etsidec, space, spacelen);
         }
@@ -950,6 +1144,149 @@ char *wandder_etsili_get_next_fieldstr(wandder_etsispec_t *etsidec, char *space,
             spacelen);
 }
 
+/* Walks the fields in the decoder 'dec', starting from the structure
+ * described by 'root', and passes each one to the visitor callback.
+ *
+ * Returns 0 if the walk completed, 1 if the callback asked us to stop and
+ * -1 if an error occurred.
+ */
+static int visit_fields(wandder_etsispec_t *etsidec, wandder_decoder_t *dec,
+        wandder_dumper_t *root, uint16_t baselevel, uint8_t decrypted,
+        wandder_etsili_visitor_cb_t cb, void *userdata) {
+
+    wandder_dumper_t *stk[WANDDER_ETSILI_VISIT_MAX_DEPTH];
+    wandder_dumper_t *curr, *descend;
+    wandder_etsili_field_t field;
+    uint16_t level;
+    uint8_t cls;
+    uint32_t ident;
+    int ret, decret;
+
+    wandder_reset_decoder(dec);
+    stk[0] = root;
+
+    while ((decret = wandder_decode_next(dec)) > 0) {
+        level = wandder_get_level(dec);
+        if (level >= WANDDER_ETSILI_VISIT_MAX_DEPTH) {
+            fprintf(stderr, "ETSI record is nested too deeply to visit\n");
+            return -1;
+        }
+
+        curr = stk[level];
+        cls = wandder_get_class(dec);
+        ident = wandder_get_identifier(dec);
+        descend = NULL;
+
+        field.parent = curr;
+        field.member = -1;
+        field.name = NULL;
+        field.fieldid = WANDDER_ETSILI_FIELD_UNKNOWN;
+        field.identclass = cls;
+        field.identifier = ident;
+        field.interpretas = WANDDER_TAG_NULL;
+        field.valptr = dec->current->valptr;
+        field.vallen = dec->current->length;
+        field.level = baselevel + level;
+        field.decrypted = decrypted;
+
+        switch(cls) {
+            case WANDDER_CLASS_CONTEXT_PRIMITIVE:
+            case WANDDER_CLASS_CONTEXT_CONSTRUCT:
+                if (curr == NULL || ident >= curr->membercount) {
+                    break;
+                }
+                field.member = (int)ident;
+                field.name = curr->members[ident].name;
+                field.fieldid = curr->members[ident].fieldid;
+                field.interpretas = curr->members[ident].interpretas;
+                if (cls == WANDDER_CLASS_CONTEXT_CONSTRUCT) {
+                    descend = curr->members[ident].descend;
+                }
+                break;
+            case WANDDER_CLASS_UNIVERSAL_PRIMITIVE:
+                field.interpretas = ident;
+                break;
+            case WANDDER_CLASS_UNIVERSAL_CONSTRUCT:
+                if (curr == NULL) {
+                    break;
+                }
+                field.name = curr->sequence.name;
+                field.fieldid = curr->sequence.fieldid;
+                field.interpretas = curr->sequence.interpretas;
+                descend = curr->sequence.descend;
+                break;
+            default:
+                return -1;
+        }
+
+        /* The encryption type is needed to decrypt the upcoming payload */
+        if (curr == &(etsidec->dumpers->encryptioncontainer) &&
+                cls == WANDDER_CLASS_CONTEXT_PRIMITIVE && ident == 0) {
+            etsidec->encrypt_method = (int)wandder_get_integer_value(
+                    dec->current, NULL);
+        }
+
+        ret = cb(&field, userdata);
+        if (ret < 0) {
+            return 1;
+        }
+
+        if (field.interpretas == WANDDER_TAG_ENCRYPTED &&
+                cls == WANDDER_CLASS_CONTEXT_PRIMITIVE && ret == 0 &&
+                dec != etsidec->decrypt_dec &&
+                decrypt_payload_item(etsidec, dec->current) == 0) {
+
+            ret = visit_fields(etsidec, etsidec->decrypt_dec,
+                    &(etsidec->dumpers->encryptedpayloadroot),
+                    baselevel + level + 1, 1, cb, userdata);
+            etsidec->decrypted = NULL;
+            if (ret != 0) {
+                return ret;
+            }
+            continue;
+        }
+
+        if (!IS_CONSTRUCTED(dec->current)) {
+            continue;
+        }
+
+        if (descend == NULL || ret > 0) {
+            /* Either we don't know what is inside this field or the
+             * caller isn't interested in it */
+            wandder_decode_skip(dec);
+            continue;
+        }
+
+        if (level + 1 >= WANDDER_ETSILI_VISIT_MAX_DEPTH) {
+            fprintf(stderr, "ETSI record is nested too deeply to visit\n");
+            return -1;
+        }
+        stk[level + 1] = descend;
+    }
+
+    if (decret < 0) {
+        /* Malformed record, don't report it as having been fully visited */
+        return -1;
+    }
+    return 0;
+}
+
+int wandder_etsili_visit(wandder_etsispec_t *etsidec,
+        wandder_etsili_visitor_cb_t cb, void *userdata) {
+
+    int ret;
+
+    if (etsidec->decstate == 0) {
+        fprintf(stderr, "No buffer attached to this decoder -- please call"
+                "wandder_attach_etsili_buffer() first!\n");
+        return -1;
+    }
+
+    ret = visit_fields(etsidec, etsidec->dec, &(etsidec->dumpers->root), 0, 0,
+            cb, userdata);
+    return (ret < 0) ? -1 : 0;
+}
+
 wandder_decoder_t *wandder_get_etsili_base_decoder(wandder_etsispec_t *dec) {
     return (dec->dec);
 }
@@ -962,14 +1299,166 @@ int wandder_etsili_get_nesting_level(wandder_etsispec_t *dec) {
     return wandder_get_level(dec->dec);
 }
 
+/* Finds the CC payload by following the (fixed) structure of a CC record
+ * directly, rather than searching the whole record for it. The variant of
+ * CC is identified from the first tag inside cCContents, which tells us
+ * exactly where the payload and any format field will be.
+ *
+ * Returns 1 if the payload was found, 0 if the record has no CC payload
+ * and -1 if the record does not have the structure we expect, in which
+ * case the caller should fall back to a full search.
+ */
+static int locate_cc_contents(wandder_etsispec_t *etsidec,
+        wandder_decoder_t *dec, uint8_t **vp, uint32_t *len, char *name,
+        int namelen) {
+
+    wandder_tape_t *tape;
+    wandder_item_t encitem;
+    int64_t payload, ccseq, ccpayload, cccontents, ind, fmt, typeind;
+    uint32_t cc;
+
+    if (etsidec->hdrtape == NULL) {
+        etsidec->hdrtape = wandder_create_tape(64);
+    }
+    tape = etsidec->hdrtape;
+
+    if (wandder_tape_parse(tape, dec->source, dec->sourcelen) <= 0) {
+        return -1;
+    }
+
+    /* Decrypted content begins with the byteCounter, then the payload */
+    if (dec == etsidec->decrypt_dec) {
+        payload = wandder_tape_find_child(tape, 0, 1);
+    } else {
+        payload = wandder_tape_find_child(tape, 0, 2);
+    }
+    if (payload < 0) {
+        return -1;
+    }
+
+    ccseq = wandder_tape_find_child(tape, (uint32_t)payload, 1);
+    if (ccseq < 0) {
+        if (dec != etsidec->dec) {
+            return 0;
+        }
+
+        /* Not a CC, unless the payload is encrypted */
+        ind = wandder_tape_find_child(tape, (uint32_t)payload, 4);
+        if (ind < 0) {
+            return 0;
+        }
+
+        typeind = wandder_tape_find_child(tape, (uint32_t)ind, 0);
+        ind = wandder_tape_find_child(tape, (uint32_t)ind, 1);
+        if (typeind < 0 || ind < 0) {
+            return -1;
+        }
+
+        etsidec->encrypt_method = (int)wandder_tape_get_integer_value(tape,
+                (uint32_t)typeind);
+        memset(&encitem, 0, sizeof(encitem));
+        encitem.valptr = wandder_tape_get_itemptr(tape, (uint32_t)ind);
+        encitem.length = tape->entries[ind].length;
+
+        if (decrypt_payload_item(etsidec, &encitem) != 0) {
+            return 0;
+        }
+        *vp = internal_get_cc_contents(etsidec, etsidec->decrypt_dec, len,
+                name, namelen);
+        return (*vp != NULL);
+    }
+
+    ccpayload = wandder_tape_find_child(tape, (uint32_t)ccseq,
+            WANDDER_TAG_SEQUENCE);
+    if (ccpayload < 0) {
+        return -1;
+    }
+    cccontents = wandder_tape_find_child(tape, (uint32_t)ccpayload, 2);
+    if (cccontents < 0) {
+        return -1;
+    }
+
+    cc = (uint32_t)cccontents + 1;
+    if (cc >= tape->entries[cccontents].next) {
+        return -1;
+    }
+
+    switch(tape->entries[cc].identifier) {
+        case 1:
+            /* emailCC */
+            ind = wandder_tape_find_child(tape, cc, 2);
+            if (ind < 0) {
+                return -1;
+            }
+            strncpy(name, etsidec->dumpers->emailcc.members[2].name, namelen);
+            fmt = wandder_tape_find_child(tape, cc, 1);
+            if (fmt >= 0) {
+                int64_t val = wandder_tape_get_integer_value(tape,
+                        (uint32_t)fmt);
+                if (val <= 255) {
+                    etsidec->ccformat = (uint8_t) val;
+                }
+            }
+            break;
+        case 2:
+            /* iPCC */
+            ind = wandder_tape_find_child(tape, cc, 1);
+            if (ind >= 0) {
+                ind = wandder_tape_find_child(tape, (uint32_t)ind, 0);
+            }
+            if (ind < 0) {
+                return -1;
+            }
+            strncpy(name, etsidec->dumpers->ipcccontents.members[0].name,
+                    namelen);
+            etsidec->ccformat = WANDDER_ETSILI_CC_FORMAT_IP;
+            break;
+        case 4:
+            /* uMTSCC */
+            ind = cc;
+            strncpy(name, etsidec->dumpers->cccontents.members[4].name,
+                    namelen);
+            etsidec->ccformat = WANDDER_ETSILI_CC_FORMAT_IP;
+            break;
+        case 12:
+            /* iPMMCC */
+            ind = wandder_tape_find_child(tape, cc, 1);
+            if (ind < 0) {
+                return -1;
+            }
+            strncpy(name, etsidec->dumpers->ipmmcc.members[1].name, namelen);
+            fmt = wandder_tape_find_child(tape, cc, 2);
+            if (fmt >= 0) {
+                etsidec->ccformat = ipmmcc_frame_type_to_format(
+                        wandder_tape_get_integer_value(tape, (uint32_t)fmt));
+            }
+            break;
+        case 17:
+            /* ePSCC */
+            ind = wandder_tape_find_child(tape, cc, 2);
+            if (ind < 0) {
+                return -1;
+            }
+            strncpy(name, etsidec->dumpers->epscc.members[2].name, namelen);
+            etsidec->ccformat = WANDDER_ETSILI_CC_FORMAT_IP;
+            break;
+        default:
+            return -1;
+    }
+
+    *vp = wandder_tape_get_itemptr(tape, (uint32_t)ind);
+    *len = tape->entries[ind].length;
+    return 1;
+}
+
 static uint8_t *internal_get_cc_contents(wandder_etsispec_t *etsidec,
         wandder_decoder_t *dec, uint32_t *len, char *name, int namelen) {
 
     uint8_t *vp = NULL;
-    int tgtcount;
     wandder_found_t *found = NULL;
-    wandder_target_t cctgts[6];
+    wandder_query_t *query;
     wandder_dumper_t *startpoint;
+    int ret;
 
     if (etsidec->decstate == 0) {
         fprintf(stderr, "No buffer attached to this decoder -- please call"
@@ -977,64 +1466,50 @@ static uint8_t *internal_get_cc_contents(wandder_etsispec_t *etsidec,
         return NULL;
     }
     etsidec->ccformat = WANDDER_ETSILI_CC_FORMAT_UNKNOWN;
+    *len = 0;
 
-    /* Find IPCCContents or IPMMCCContents or UMTSCC or emailCC or epsCC */
-    cctgts[0].parent = &etsidec->ipcccontents;
-    cctgts[0].itemid = 0;
-    cctgts[0].found = false;
-
-    cctgts[1].parent = &etsidec->ipmmcc;
-    cctgts[1].itemid = 1;
-    cctgts[1].found = false;
-
-    cctgts[2].parent = &etsidec->cccontents;
-    cctgts[2].itemid = 4;
-    cctgts[2].found = false;
-
-    cctgts[3].parent = &etsidec->emailcc;
-    cctgts[3].itemid = 2;
-    cctgts[3].found = false;
+    /* Callers expect the decoder to be back at the start of the record */
+    wandder_reset_decoder(dec);
 
-    cctgts[4].parent = &etsidec->epscc;
-    cctgts[4].itemid = 2;
-    cctgts[4].found = false;
+    ret = locate_cc_contents(etsidec, dec, &vp, len, name, namelen);
+    if (ret == 1) {
+        return vp;
+    }
+    if (ret == 0) {
+        *len = 0;
+        return NULL;
+    }
 
     if (dec == etsidec->dec) {
         /* Also look for encrypted payload */
-        tgtcount = 6;
-        cctgts[5].parent = &etsidec->payload;
-        cctgts[5].itemid = 4;
-        cctgts[5].found = false;
-        startpoint = &(etsidec->root);
+        query = etsidec->dumpers->cc_query;
     } else if (dec == etsidec->decrypt_dec) {
-        tgtcount = 5;
-        startpoint = &(etsidec->encryptedpayloadroot);
+        query = etsidec->dumpers->cc_query_decrypted;
     } else {
-        tgtcount = 5;
-        startpoint = &(etsidec->root);
+        query = etsidec->dumpers->cc_query_noencrypt;
     }
+    startpoint = query->root;
 
     wandder_reset_decoder(dec);
     *len = 0;
-    if (wandder_search_items(dec, 0, startpoint, cctgts,
-                tgtcount, &found, 1) > 0) {
+    if (wandder_execute_query(dec, query, &found, 1) > 0) {
         *len = found->list[0].item->length;
         vp = found->list[0].item->valptr;
 
         if (found->list[0].targetid == 0) {
-            strncpy(name, etsidec->ipcccontents.members[0].name, namelen);
+            strncpy(name, etsidec->dumpers->ipcccontents.members[0].name, namelen);
             etsidec->ccformat = WANDDER_ETSILI_CC_FORMAT_IP;
         } else if (found->list[0].targetid == 1) {
-            strncpy(name, etsidec->ipmmcc.members[1].name, namelen);
+            strncpy(name, etsidec->dumpers->ipmmcc.members[1].name, namelen);
             wandder_etsili_get_ipmmcc_format(etsidec, dec, startpoint);
         } else if (found->list[0].targetid == 2) {
-            strncpy(name, etsidec->cccontents.members[4].name, namelen);
+            strncpy(name, etsidec->dumpers->cccontents.members[4].name, namelen);
             etsidec->ccformat = WANDDER_ETSILI_CC_FORMAT_IP;
         } else if (found->list[0].targetid == 3) {
-            strncpy(name, etsidec->emailcc.members[2].name, namelen);
+            strncpy(name, etsidec->dumpers->emailcc.members[2].name, namelen);
             wandder_etsili_get_email_format(etsidec, dec, startpoint);
         } else if (found->list[0].targetid == 4) {
-            strncpy(name, etsidec->epscc.members[2].name, namelen);
+            strncpy(name, etsidec->dumpers->epscc.members[2].name, namelen);
             etsidec->ccformat = WANDDER_ETSILI_CC_FORMAT_IP;
         } else if (found->list[0].targetid == 5) {
             if (decrypt_encryption_container(etsidec, found->list[0].item)) {
@@ -1061,14 +1536,11 @@ uint8_t *wandder_etsili_get_cc_contents(wandder_etsispec_t *etsidec,
      * and cached the content to save time? */
     if (etsidec->saved_decrypted_payload) {
         assert(etsidec->saved_payload_name != NULL);
-        if (strcmp(etsidec->saved_payload_name, "sIPContent") == 0) {
-            return NULL;
-        }
-        if (strcmp(etsidec->saved_payload_name, "originalIPMMMessage") == 0) {
-            return NULL;
-        }
-        if (strcmp(etsidec->saved_payload_name, "h323Message") == 0) {
-            return NULL;
+        switch(etsidec->saved_payload_fieldid) {
+            case WANDDER_ETSILI_FIELD_sIPContent:
+            case WANDDER_ETSILI_FIELD_originalIPMMMessage:
+            case WANDDER_ETSILI_FIELD_h323Message:
+                return NULL;
         }
         strncpy(name, etsidec->saved_payload_name, namelen);
         *len = etsidec->saved_payload_size;
@@ -1087,13 +1559,13 @@ uint8_t *wandder_etsili_get_encryption_container(
     uint8_t *vp = NULL;
 
     wandder_reset_decoder(dec);
-    target.parent = &etsidec->payload;
+    target.parent = &etsidec->dumpers->payload;
     target.itemid = 4;
     target.found = false;
 
     *len = 0;
 
-    if (wandder_search_items(dec, 0, &(etsidec->root), &target, 1,
+    if (wandder_search_items(dec, 0, &(etsidec->dumpers->root), &target, 1,
                 &found, 1) > 0) {
         *len = found->list[0].item->length;
         vp = found->list[0].item->valptr;
@@ -1112,13 +1584,13 @@ uint8_t *wandder_etsili_get_integrity_check_contents(
     uint8_t *vp = NULL;
 
     wandder_reset_decoder(dec);
-    target.parent = &etsidec->payload;
+    target.parent = &etsidec->dumpers->payload;
     target.itemid = 2;
     target.found = false;
 
     *len = 0;
 
-    if (wandder_search_items(dec, 0, &(etsidec->root), &target, 1,
+    if (wandder_search_items(dec, 0, &(etsidec->dumpers->root), &target, 1,
                 &found, 1) > 0) {
         *len = found->list[0].item->length;
         vp = found->list[0].item->valptr;
@@ -1134,54 +1606,28 @@ static uint8_t *internal_get_iri_contents(wandder_etsispec_t *etsidec,
 
     uint8_t *vp = NULL;
     wandder_found_t *found = NULL;
-    wandder_target_t iritgts[4];
-    wandder_dumper_t *startpoint;
-    int tgtcount = 4;
+    wandder_query_t *query;
 
     if (dec == etsidec->decrypt_dec) {
-        startpoint = &(etsidec->encryptedpayloadroot);
-        tgtcount = 3;
+        query = etsidec->dumpers->iri_query_decrypted;
     } else {
-        startpoint = &(etsidec->root);
+        query = etsidec->dumpers->iri_query;
     }
 
     wandder_reset_decoder(dec);
-    /* originalIPMMMessage */
-    iritgts[0].parent = &etsidec->ipmmiricontents;
-    iritgts[0].itemid = 0;
-    iritgts[0].found = false;
-
-    /* sIPContents */
-    iritgts[1].parent = &etsidec->sipmessage;
-    iritgts[1].itemid = 2;
-    iritgts[1].found = false;
-
-    /* rawAAAData */
-    iritgts[2].parent = &etsidec->ipiricontents;
-    iritgts[2].itemid = 15;
-    iritgts[2].found = false;
-
-    /* encryptedContainer */
-    iritgts[3].parent = &etsidec->payload;
-    iritgts[3].itemid = 4;
-    iritgts[3].found = false;
-
-    /* TODO H323 contents... */
-
     *len = 0;
-    if (wandder_search_items(dec, 0, startpoint, iritgts, tgtcount,
-                &found, 1) > 0) {
+    if (wandder_execute_query(dec, query, &found, 1) > 0) {
         *len = found->list[0].item->length;
         vp = found->list[0].item->valptr;
 
         if (found->list[0].targetid == 0) {
-            strncpy(name, etsidec->ipmmiricontents.members[0].name, namelen);
+            strncpy(name, etsidec->dumpers->ipmmiricontents.members[0].name, namelen);
             *ident = WANDDER_IRI_CONTENT_IP;
         } else if (found->list[0].targetid == 1) {
-            strncpy(name, etsidec->sipmessage.members[2].name, namelen);
+            strncpy(name, etsidec->dumpers->sipmessage.members[2].name, namelen);
             *ident = WANDDER_IRI_CONTENT_SIP;
         } else if (found->list[0].targetid == 2) {
-            strncpy(name, etsidec->ipiricontents.members[15].name, namelen);
+            strncpy(name, etsidec->dumpers->ipiricontents.members[15].name, namelen);
             *ident = WANDDER_IRI_CONTENT_IP;   // right?
         } else if (found->list[0].targetid == 3) {
             if (decrypt_encryption_container(etsidec, found->list[0].item)) {
@@ -1205,26 +1651,20 @@ uint8_t *wandder_etsili_get_iri_contents(wandder_etsispec_t *etsidec,
     }
     if (etsidec->saved_decrypted_payload) {
         assert(etsidec->saved_payload_name != NULL);
-        if (strcmp(etsidec->saved_payload_name, "sIPContent") == 0) {
-            strncpy(name, etsidec->saved_payload_name, namelen);
-            *len = etsidec->saved_payload_size;
-            *ident = WANDDER_IRI_CONTENT_SIP;
-            return etsidec->saved_decrypted_payload;
-        } else if (strcmp(etsidec->saved_payload_name,
-                "originalIPMMMessage") == 0) {
-            strncpy(name, etsidec->saved_payload_name, namelen);
-            *len = etsidec->saved_payload_size;
-            *ident = WANDDER_IRI_CONTENT_IP;
-            return etsidec->saved_decrypted_payload;
-        } else if (strcmp(etsidec->saved_payload_name,
-                "h323Message") == 0) {
-            strncpy(name, etsidec->saved_payload_name, namelen);
-            *len = etsidec->saved_payload_size;
-            *ident = WANDDER_IRI_CONTENT_IP;
-            return etsidec->saved_decrypted_payload;
-        } else {
-            return NULL;
+        switch(etsidec->saved_payload_fieldid) {
+            case WANDDER_ETSILI_FIELD_sIPContent:
+                *ident = WANDDER_IRI_CONTENT_SIP;
+                break;
+            case WANDDER_ETSILI_FIELD_originalIPMMMessage:
+            case WANDDER_ETSILI_FIELD_h323Message:
+                *ident = WANDDER_IRI_CONTENT_IP;
+                break;
+            default:
+                return NULL;
         }
+        strncpy(name, etsidec->saved_payload_name, namelen);
+        *len = etsidec->saved_payload_size;
+        return etsidec->saved_decrypted_payload;
     }
 
     return internal_get_iri_contents(etsidec, etsidec->dec, len, ident,
@@ -1409,6 +1849,151 @@ int64_t wandder_etsili_get_sequence_number(wandder_etsispec_t *etsidec) {
     return decode_sequence_number(etsidec->dec);
 }
 
+/* Extracts every PSHeader field in a single walk over the header, rather
+ * than re-decoding the header once for each field as the individual
+ * getters (get_liid, get_cin, etc.) have to.
+ *
+ * Returns 1 if the header was decoded, 0 if there is no PSHeader and -1
+ * if an error occurred.
+ */
+int wandder_etsili_get_header(wandder_etsispec_t *etsidec,
+        wandder_etsili_header_t *hdr) {
+
+    uint32_t ident;
+    uint16_t baselevel, level;
+    int ret;
+    wandder_item_t *item;
+    wandder_decoder_t *dec = etsidec->dec;
+    uint8_t gotts = 0;
+
+    memset(hdr, 0, sizeof(wandder_etsili_header_t));
+    hdr->cin = -1;
+    hdr->seqno = -1;
+
+    if (etsidec->decstate == 0) {
+        fprintf(stderr, "No buffer attached to this decoder -- please call"
+                "wandder_attach_etsili_buffer() first!\n");
+        return -1;
+    }
+
+    wandder_reset_decoder(dec);
+    QUICK_DECODE(-1);
+    QUICK_DECODE(-1);
+    if (ident != 1) {
+        return 0;
+    }
+    baselevel = wandder_get_level(dec);
+
+    while (1) {
+        ret = wandder_decode_next(dec);
+        if (ret < 0) {
+            return -1;
+        }
+        if (ret == 0) {
+            break;
+        }
+
+        item = dec->current;
+        level = item->level;
+        ident = item->identifier;
+
+        if (level <= baselevel) {
+            /* Walked off the end of the PSHeader */
+            break;
+        }
+
+        if (level == baselevel + 1) {
+            switch(ident) {
+                case 1:
+                    hdr->liid = item->valptr;
+                    hdr->liid_len = item->length;
+                    break;
+                case 2:
+                    hdr->authcc = item->valptr;
+                    hdr->authcc_len = item->length;
+                    break;
+                case 3:
+                    /* communicationIdentifier -- descend into it */
+                    break;
+                case 4:
+                    hdr->seqno = wandder_get_integer_value(item, NULL);
+                    break;
+                case 5:
+                    hdr->ts = wandder_generalizedts_to_timeval(dec,
+                            (char *)item->valptr, item->length);
+                    gotts = 1;
+                    break;
+                case 6:
+                    hdr->intpointid = item->valptr;
+                    hdr->intpointid_len = item->length;
+                    break;
+                case 7:
+                    /* microSecondTimeStamp -- only used if there was no
+                     * generalized timestamp, for consistency with
+                     * wandder_etsili_get_header_timestamp() */
+                    if (gotts) {
+                        wandder_decode_skip(dec);
+                    }
+                    break;
+                default:
+                    if (IS_CONSTRUCTED(item)) {
+                        wandder_decode_skip(dec);
+                    }
+                    break;
+            }
+            continue;
+        }
+
+        if (level == baselevel + 2 && item->parent->identifier == 3) {
+            switch(ident) {
+                case 0:
+                    /* networkIdentifier -- descend into it */
+                    break;
+                case 1:
+                    hdr->cin = wandder_get_integer_value(item, NULL);
+                    break;
+                case 2:
+                    hdr->delivcc = item->valptr;
+                    hdr->delivcc_len = item->length;
+                    break;
+                default:
+                    if (IS_CONSTRUCTED(item)) {
+                        wandder_decode_skip(dec);
+                    }
+                    break;
+            }
+            continue;
+        }
+
+        if (level == baselevel + 2 && item->parent->identifier == 7) {
+            if (ident == 0) {
+                hdr->ts.tv_sec = wandder_get_integer_value(item, NULL);
+            } else if (ident == 1) {
+                hdr->ts.tv_usec = wandder_get_integer_value(item, NULL);
+            }
+            continue;
+        }
+
+        if (level == baselevel + 3 && item->parent->identifier == 0) {
+            if (ident == 0) {
+                hdr->operatorid = item->valptr;
+                hdr->operatorid_len = item->length;
+                continue;
+            } else if (ident == 1) {
+                hdr->networkelemid = item->valptr;
+                hdr->networkelemid_len = item->length;
+                continue;
+            }
+        }
+
+        if (IS_CONSTRUCTED(item)) {
+            wandder_decode_skip(dec);
+        }
+    }
+
+    return 1;
+}
+
 static char *stringify_3gcause(wandder_etsispec_t *etsidec,
         wandder_item_t *item, wandder_dumper_t *curr, char *valstr, int len) {
 
@@ -2178,7 +2763,7 @@ static int decrypt_encryption_container(wandder_etsispec_t *etsidec,
     uint32_t ident;
     char valstr[16384];
 
-    dec = init_wandder_decoder(dec, item->valptr, item->length, 0);
+    dec = init_wandder_decoder_small(dec, item->valptr, item->length, 0);
 
     /* get the encryption type */
     QUICK_DECODE(thisret);
@@ -2202,37 +2787,73 @@ static int decrypt_encryption_container(wandder_etsispec_t *etsidec,
     return thisret;
 }
 
-#define DECRYPT_INIT \
-    decrypted = calloc(1, item->length * 2); \
-    decrypt_size = item->length * 2; \
-    ciphertext = calloc(1, item->length + 1); \
-    memcpy(ciphertext, (uint8_t *)(item->valptr), item->length); \
-    seqdec = init_wandder_decoder(seqdec, etsidec->dec->source, \
-            etsidec->dec->sourcelen, 0); \
-    seqno = decode_sequence_number(seqdec); \
-    seq32 = (int32_t)(seqno & 0xFFFFFFFF); \
-    free_wandder_decoder(seqdec); \
+/* Finds the sequence number for the PDU attached to the decoder without
+ * disturbing the state of the main decoder, which may be part way through
+ * the PDU.
+ *
+ * Only the PSHeader is parsed onto the tape -- the PSHeader is the first
+ * member of the PS-PDU, so we can skip straight past the outer tag and
+ * length and never have to index the (encrypted) payload.
+ */
+static int64_t peek_sequence_number(wandder_etsispec_t *etsidec) {
 
-static char *decrypt_encrypted_payload_item(wandder_etsispec_t *etsidec,
-        wandder_item_t *item, char *valstr, int len) {
+    uint8_t *source = etsidec->dec->source;
+    uint32_t sourcelen = etsidec->dec->sourcelen;
+    int lenlen = 0;
+    int64_t ind;
+
+    if (sourcelen < 2) {
+        return -1;
+    }
+
+    decode_length_field(source + 1, sourcelen - 1, &lenlen);
+    if (lenlen == 0 || (uint32_t)lenlen + 1 >= sourcelen) {
+        return -1;
+    }
+
+    if (etsidec->hdrtape == NULL) {
+        etsidec->hdrtape = wandder_create_tape(64);
+    }
+
+    if (wandder_tape_parse(etsidec->hdrtape, source + 1 + lenlen,
+                sourcelen - 1 - lenlen) <= 0) {
+        return -1;
+    }
+
+    if (etsidec->hdrtape->entries[0].identifier != 1) {
+        return -1;
+    }
+
+    ind = wandder_tape_find_child(etsidec->hdrtape, 0, 4);
+    if (ind < 0) {
+        return -1;
+    }
+    return wandder_tape_get_integer_value(etsidec->hdrtape, (uint32_t)ind);
+}
+
+/* Decrypts the encrypted payload 'item' and prepares the decrypt_dec
+ * decoder for decoding the decrypted content.
+ *
+ * Returns 0 if decryption was successful, -1 otherwise.
+ */
+static int decrypt_payload_item(wandder_etsispec_t *etsidec,
+        wandder_item_t *item) {
 
-    uint8_t *ciphertext = NULL;
-    wandder_decoder_t *seqdec = NULL;
     int64_t seqno;
     int32_t seq32;
-    char *keyenv;
     uint8_t *decrypted = NULL;
-    int decrypt_size;
     int dlen = 0;
 
-    keyenv = getenv("LIBWANDDER_ETSILI_DECRYPTION_KEY");
     if (etsidec->encrypt_method == WANDDER_ENCRYPTION_TYPE_NONE) {
-        etsidec->decrypted = calloc(1, item->length);
-        memcpy(etsidec->decrypted, item->valptr, item->length);
-        etsidec->decrypt_size = item->length;
+        decrypted = get_decrypt_buffer(etsidec, item->length);
+        memcpy(decrypted, item->valptr, item->length);
+        dlen = item->length;
         goto decryptsuccess;
     } else if (etsidec->encrypt_method == WANDDER_ENCRYPTION_TYPE_AES_192_CBC) {
-        DECRYPT_INIT
+        /* Room for an extra block, just in case */
+        decrypted = get_decrypt_buffer(etsidec, item->length + 16);
+        seqno = peek_sequence_number(etsidec);
+        seq32 = (int32_t)(seqno & 0xFFFFFFFF);
     } else if (etsidec->encrypt_method == WANDDER_ENCRYPTION_TYPE_NOT_STATED) {
         goto decryptfail;
     } else {
@@ -2241,26 +2862,16 @@ static char *decrypt_encrypted_payload_item(wandder_etsispec_t *etsidec,
         goto decryptfail;
     }
 
-    if (etsidec->encrypt_method == WANDDER_ENCRYPTION_TYPE_AES_192_CBC) {
-        char *dkey = NULL;
-        if (etsidec->decryption_key) {
-            dkey = etsidec->decryption_key;
-        } else {
-            dkey = keyenv;
-        }
-
-        if ((dlen = decrypt_payload_content_aes_192_cbc(ciphertext,
-                item->length,
-                dkey, seq32, (unsigned char *)decrypted, decrypt_size)) < 0) {
-            goto decryptfail;
-        }
+    if ((dlen = decrypt_payload_content_aes_192_cbc(etsidec, item->valptr,
+            item->length, seq32, (unsigned char *)decrypted)) < 0) {
+        goto decryptfail;
     }
 
     /* Do some sanity checks on the decrypted content, just in case we
      * were given the wrong key...
      */
 
-    if (decrypted[0] != 0x30) {
+    if (dlen == 0 || decrypted[0] != 0x30) {
         fprintf(stderr, "Decrypted payload does not begin with expected 0x30 byte -- provided key is probably incorrect?\n");
         goto decryptfail;
     }
@@ -2270,26 +2881,171 @@ static char *decrypt_encrypted_payload_item(wandder_etsispec_t *etsidec,
         goto decryptfail;
     }
 
-    free(ciphertext);
+decryptsuccess:
     etsidec->decrypted = decrypted;
-    etsidec->decrypt_size = decrypt_size;
+    etsidec->decrypt_size = dlen;
 
-decryptsuccess:
+    /* The plaintext buffer is re-used, so make sure the decoder doesn't
+     * hang on to any items from the previous decrypted payload */
+    if (etsidec->decrypt_dec) {
+        wandder_reset_decoder(etsidec->decrypt_dec);
+    }
     etsidec->decrypt_dec = init_wandder_decoder(etsidec->decrypt_dec,
             etsidec->decrypted, etsidec->decrypt_size, 0);
 
-    return NULL;
+    return 0;
 
 decryptfail:
-    if (ciphertext) {
-        free(ciphertext);
-    }
-    if (decrypted) {
-        free(decrypted);
+    return -1;
+}
+
+static char *decrypt_encrypted_payload_item(wandder_etsispec_t *etsidec,
+        wandder_item_t *item, char *valstr, int len) {
+
+    if (decrypt_payload_item(etsidec, item) == 0) {
+        return NULL;
     }
+
     /* unable to decrypt, fall back to hex decoding */
     return stringify_bytes_as_hex(etsidec, item, valstr, len);
+}
+
+/* Fills in a decryption job using the encryption container in the PDU
+ * that is currently attached to the decoder.
+ *
+ * Returns 1 if the job was prepared, 0 if the PDU has no encrypted
+ * payload and -1 if the PDU could not be parsed.
+ */
+int wandder_etsili_prepare_decrypt_job(wandder_etsispec_t *etsidec,
+        wandder_etsili_decrypt_job_t *job) {
+
+    uint32_t seqpath[2] = {1, 4};
+    uint32_t typepath[3] = {2, 4, 0};
+    uint32_t payloadpath[3] = {2, 4, 1};
+    int64_t ind;
+
+    memset(job, 0, sizeof(wandder_etsili_decrypt_job_t));
+    job->seqno = -1;
+
+    if (etsidec->decstate == 0) {
+        fprintf(stderr, "No buffer attached to this decoder -- please call"
+                "wandder_attach_etsili_buffer() first!\n");
+        return -1;
+    }
+
+    if (etsidec->hdrtape == NULL) {
+        etsidec->hdrtape = wandder_create_tape(64);
+    }
+
+    if (wandder_tape_parse(etsidec->hdrtape, etsidec->dec->source,
+                etsidec->dec->sourcelen) <= 0) {
+        return -1;
+    }
+
+    ind = wandder_tape_find_path(etsidec->hdrtape, 0, payloadpath, 3);
+    if (ind < 0) {
+        return 0;
+    }
+    job->ciphertext = wandder_tape_get_itemptr(etsidec->hdrtape,
+            (uint32_t)ind);
+    job->cipherlen = etsidec->hdrtape->entries[ind].length;
+
+    ind = wandder_tape_find_path(etsidec->hdrtape, 0, typepath, 3);
+    if (ind >= 0) {
+        job->encrypt_method = (int)wandder_tape_get_integer_value(
+                etsidec->hdrtape, (uint32_t)ind);
+    }
+
+    ind = wandder_tape_find_path(etsidec->hdrtape, 0, seqpath, 2);
+    if (ind >= 0) {
+        job->seqno = wandder_tape_get_integer_value(etsidec->hdrtape,
+                (uint32_t)ind);
+    }
+    return 1;
+}
+
+/* Decrypts a set of encrypted payloads in one pass, using the key and
+ * cipher context belonging to 'etsidec'. All of the plaintext is written
+ * into a single buffer so no per-payload allocation is required.
+ *
+ * Jobs that could not be decrypted will have their plaintext set to NULL.
+ *
+ * Returns the number of jobs that were successfully decrypted, or -1 if
+ * no decryption key is available.
+ */
+int wandder_etsili_decrypt_batch(wandder_etsispec_t *etsidec,
+        wandder_etsili_decrypt_job_t *jobs, int count) {
+
+    uint64_t required = 0;
+    uint8_t *plain;
+    int i, dlen, done = 0;
+
+    for (i = 0; i < count; i++) {
+        jobs[i].plaintext = NULL;
+        jobs[i].plainlen = 0;
+        if (jobs[i].encrypt_method == WANDDER_ENCRYPTION_TYPE_AES_192_CBC) {
+            required += jobs[i].cipherlen;
+        }
+    }
+
+    if (required > 0) {
+        if (!load_decryption_key(etsidec)) {
+            fprintf(stderr, "Unable to decrypt payload content as no encryption key has been provided.\nUse LIBWANDDER_ETSILI_DECRYPTION_KEY environment variable or\nwandder_set_etsili_decryption_key() function to provide the key.\n");
+            return -1;
+        }
+
+        if (required > UINT32_MAX) {
+            fprintf(stderr, "Batch of encrypted payloads is too large to decrypt in one go\n");
+            return -1;
+        }
+
+        if (etsidec->batch_buf_alloced < required) {
+            if (etsidec->batch_buf) {
+                free(etsidec->batch_buf);
+            }
+            etsidec->batch_buf = malloc(required);
+            if (etsidec->batch_buf == NULL) {
+                etsidec->batch_buf_alloced = 0;
+                fprintf(stderr, "Unable to allocate memory for batch decryption: %s\n",
+                        strerror(errno));
+                return -1;
+            }
+            etsidec->batch_buf_alloced = required;
+        }
+    }
+
+    plain = etsidec->batch_buf;
+    for (i = 0; i < count; i++) {
+        if (jobs[i].encrypt_method == WANDDER_ENCRYPTION_TYPE_NONE) {
+            /* Nothing to do, just point at the original content */
+            jobs[i].plaintext = jobs[i].ciphertext;
+            jobs[i].plainlen = jobs[i].cipherlen;
+            done ++;
+            continue;
+        }
+
+        if (jobs[i].encrypt_method != WANDDER_ENCRYPTION_TYPE_AES_192_CBC) {
+            continue;
+        }
+
+        /* Padding is disabled, so the plaintext is never larger than
+         * the ciphertext */
+        dlen = decrypt_payload_content_aes_192_cbc(etsidec,
+                jobs[i].ciphertext, jobs[i].cipherlen,
+                (int32_t)(jobs[i].seqno & 0xFFFFFFFF), plain);
+        if (dlen <= 0 || plain[0] != 0x30 ||
+                decrypt_length_sanity_check(plain, (uint64_t)dlen) == 0) {
+            plain += jobs[i].cipherlen;
+            continue;
+        }
+
+        jobs[i].plaintext = plain;
+        jobs[i].plainlen = dlen;
+        plain += jobs[i].cipherlen;
+        done ++;
+    }
 
+    return done;
 }
 
 static char *stringify_domain_name(wandder_etsispec_t *etsidec,
@@ -2372,7 +3128,7 @@ static char *interpret_enum(wandder_etsispec_t *etsidec, wandder_item_t *item,
         return NULL;
     }
 
-    if (item->identifier == 1 && curr == &(etsidec->ipaddress)) {
+    if (item->identifier == 1 && curr == &(etsidec->dumpers->ipaddress)) {
         /* iP-type */
         switch(enumval) {
             case 0:
@@ -2384,7 +3140,7 @@ static char *interpret_enum(wandder_etsispec_t *etsidec, wandder_item_t *item,
         }
     }
 
-    else if (item->identifier == 3 && curr == &(etsidec->ipaddress)) {
+    else if (item->identifier == 3 && curr == &(etsidec->dumpers->ipaddress)) {
         /* iP-assignment */
         switch(enumval) {
             case 1:
@@ -2399,9 +3155,9 @@ static char *interpret_enum(wandder_etsispec_t *etsidec, wandder_item_t *item,
         }
     }
 
-    else if ((item->identifier == 0 && curr == &(etsidec->ccpayload)) ||
-             (item->identifier == 5 && curr == &(etsidec->iripayload)) ||
-             (item->identifier == 6 && curr == &(etsidec->iripayload))) {
+    else if ((item->identifier == 0 && curr == &(etsidec->dumpers->ccpayload)) ||
+             (item->identifier == 5 && curr == &(etsidec->dumpers->iripayload)) ||
+             (item->identifier == 6 && curr == &(etsidec->dumpers->iripayload))) {
         /* payloadDirection */
         switch(enumval) {
             case 0:
@@ -2422,7 +3178,7 @@ static char *interpret_enum(wandder_etsispec_t *etsidec, wandder_item_t *item,
         }
     }
 
-    else if (item->identifier == 1 && curr == &(etsidec->integritycheck)) {
+    else if (item->identifier == 1 && curr == &(etsidec->dumpers->integritycheck)) {
         /* checkType */
         switch (enumval) {
             case 1:
@@ -2434,7 +3190,7 @@ static char *interpret_enum(wandder_etsispec_t *etsidec, wandder_item_t *item,
         }
     }
 
-    else if (item->identifier == 2 && curr == &(etsidec->integritycheck)) {
+    else if (item->identifier == 2 && curr == &(etsidec->dumpers->integritycheck)) {
         /* dataType */
         switch (enumval) {
             case 1:
@@ -2448,7 +3204,7 @@ static char *interpret_enum(wandder_etsispec_t *etsidec, wandder_item_t *item,
                 break;
         }
     }
-    else if (item->identifier == 4 && curr == &(etsidec->integritycheck)) {
+    else if (item->identifier == 4 && curr == &(etsidec->dumpers->integritycheck)) {
         /* dataType */
         switch (enumval) {
             case 1:
@@ -2466,9 +3222,9 @@ static char *interpret_enum(wandder_etsispec_t *etsidec, wandder_item_t *item,
         }
     }
 
-    else if ((item->identifier == 4 && curr == &(etsidec->ccpayload)) ||
-            (item->identifier == 4 && curr == &(etsidec->iripayload)) ||
-            (item->identifier == 8 && curr == &(etsidec->psheader))) {
+    else if ((item->identifier == 4 && curr == &(etsidec->dumpers->ccpayload)) ||
+            (item->identifier == 4 && curr == &(etsidec->dumpers->iripayload)) ||
+            (item->identifier == 8 && curr == &(etsidec->dumpers->psheader))) {
         /* timeStampQualifier */
         switch(enumval) {
             case 0:
@@ -2486,7 +3242,7 @@ static char *interpret_enum(wandder_etsispec_t *etsidec, wandder_item_t *item,
         }
     }
 
-    else if (item->identifier == 0 && curr == &(etsidec->ipiricontents)) {
+    else if (item->identifier == 0 && curr == &(etsidec->dumpers->ipiricontents)) {
         /* accessEventType */
         switch(enumval) {
             case 0:
@@ -2525,7 +3281,7 @@ static char *interpret_enum(wandder_etsispec_t *etsidec, wandder_item_t *item,
         }
     }
 
-    else if (item->identifier == 2 && curr == &(etsidec->ipiricontents)) {
+    else if (item->identifier == 2 && curr == &(etsidec->dumpers->ipiricontents)) {
         /* internetAccessType */
         switch(enumval) {
             case 0:
@@ -2561,7 +3317,7 @@ static char *interpret_enum(wandder_etsispec_t *etsidec, wandder_item_t *item,
         }
     }
 
-    else if (item->identifier == 3 && curr == &(etsidec->ipiricontents)) {
+    else if (item->identifier == 3 && curr == &(etsidec->dumpers->ipiricontents)) {
         /* iPVersion */
         switch(enumval) {
             case 1:
@@ -2576,7 +3332,7 @@ static char *interpret_enum(wandder_etsispec_t *etsidec, wandder_item_t *item,
         }
     }
 
-    else if (item->identifier == 12 && curr == &(etsidec->ipiricontents)) {
+    else if (item->identifier == 12 && curr == &(etsidec->dumpers->ipiricontents)) {
         /* endReason */
         switch(enumval) {
             case 0:
@@ -2597,7 +3353,7 @@ static char *interpret_enum(wandder_etsispec_t *etsidec, wandder_item_t *item,
         }
     }
 
-    else if (item->identifier == 22 && curr == &(etsidec->ipiricontents)) {
+    else if (item->identifier == 22 && curr == &(etsidec->dumpers->ipiricontents)) {
         /* authenticationType */
         switch(enumval) {
             case 0:
@@ -2618,7 +3374,7 @@ static char *interpret_enum(wandder_etsispec_t *etsidec, wandder_item_t *item,
         }
     }
 
-    else if (item->identifier == 0 && curr == &(etsidec->iripayload)) {
+    else if (item->identifier == 0 && curr == &(etsidec->dumpers->iripayload)) {
         /* iRIType */
         switch(enumval) {
             case 1:
@@ -2637,7 +3393,7 @@ static char *interpret_enum(wandder_etsispec_t *etsidec, wandder_item_t *item,
         }
     }
 
-    else if (item->identifier == 0 && curr == &(etsidec->operatorleamessage)) {
+    else if (item->identifier == 0 && curr == &(etsidec->dumpers->operatorleamessage)) {
         /* messagePriority for operatorLeaMessage */
         switch(enumval) {
             case 1:
@@ -2649,7 +3405,7 @@ static char *interpret_enum(wandder_etsispec_t *etsidec, wandder_item_t *item,
         }
     }
 
-    else if (item->identifier == 2 && curr == &(etsidec->ipmmcc)) {
+    else if (item->identifier == 2 && curr == &(etsidec->dumpers->ipmmcc)) {
         /* frameType for iPMMCC */
         switch(enumval) {
             case 0:
@@ -2676,7 +3432,7 @@ static char *interpret_enum(wandder_etsispec_t *etsidec, wandder_item_t *item,
         }
     }
 
-    else if (item->identifier == 4 && curr == &(etsidec->ipmmcc)) {
+    else if (item->identifier == 4 && curr == &(etsidec->dumpers->ipmmcc)) {
         /* mMCCprotocol for iPMMCC */
         switch(enumval) {
             case 0:
@@ -2691,8 +3447,8 @@ static char *interpret_enum(wandder_etsispec_t *etsidec, wandder_item_t *item,
         }
     }
 
-    else if (item->identifier == 4 && (curr == &(etsidec->umtsiri_params) ||
-                curr == &(etsidec->epsiri_params))) {
+    else if (item->identifier == 4 && (curr == &(etsidec->dumpers->umtsiri_params) ||
+                curr == &(etsidec->dumpers->epsiri_params))) {
         /* initiator for uMTSIRI */
         switch(enumval) {
             case 0:
@@ -2706,7 +3462,7 @@ static char *interpret_enum(wandder_etsispec_t *etsidec, wandder_item_t *item,
                 break;
         }
     }
-    else if (item->identifier == 23 && curr == &(etsidec->umtsiri_params)) {
+    else if (item->identifier == 23 && curr == &(etsidec->dumpers->umtsiri_params)) {
         /* iRIversion for uMTSIRI */
         switch(enumval) {
             case 2:
@@ -2726,7 +3482,7 @@ static char *interpret_enum(wandder_etsispec_t *etsidec, wandder_item_t *item,
                 break;
         }
     }
-    else if (item->identifier == 20 && curr == &(etsidec->umtsiri_params)) {
+    else if (item->identifier == 20 && curr == &(etsidec->dumpers->umtsiri_params)) {
         /* gPRSevent for uMTSIRI */
         switch (enumval) {
             case 1:
@@ -2782,7 +3538,7 @@ static char *interpret_enum(wandder_etsispec_t *etsidec, wandder_item_t *item,
                 break;
         }
     }
-    else if (item->identifier == 1 && curr == &(etsidec->localtimestamp)) {
+    else if (item->identifier == 1 && curr == &(etsidec->dumpers->localtimestamp)) {
         /* winterSummerIndication from localTimestamp */
         switch(enumval) {
             case 0:
@@ -2796,7 +3552,7 @@ static char *interpret_enum(wandder_etsispec_t *etsidec, wandder_item_t *item,
                 break;
         }
     }
-    else if (item->identifier == 0 && curr == &(etsidec->partyinfo)) {
+    else if (item->identifier == 0 && curr == &(etsidec->dumpers->partyinfo)) {
         /* party-Qualifier for partyInformation */
         /* strangely, there's only one valid value for this enum */
         switch(enumval) {
@@ -2805,7 +3561,7 @@ static char *interpret_enum(wandder_etsispec_t *etsidec, wandder_item_t *item,
                 break;
         }
     }
-    else if (item->identifier == 1 && curr == &(etsidec->emailiri)) {
+    else if (item->identifier == 1 && curr == &(etsidec->dumpers->emailiri)) {
         /* email eventType */
         switch(enumval) {
             case 1:
@@ -2837,7 +3593,7 @@ static char *interpret_enum(wandder_etsispec_t *etsidec, wandder_item_t *item,
                 break;
         }
     }
-    else if (item->identifier == 8 && curr == &(etsidec->emailiri)) {
+    else if (item->identifier == 8 && curr == &(etsidec->dumpers->emailiri)) {
         /* E-mail-Protocol */
         switch(enumval) {
             case 1:
@@ -2857,7 +3613,7 @@ static char *interpret_enum(wandder_etsispec_t *etsidec, wandder_item_t *item,
                 break;
         }
     }
-    else if (item->identifier == 11 && curr == &(etsidec->emailiri)) {
+    else if (item->identifier == 11 && curr == &(etsidec->dumpers->emailiri)) {
         /* E-mail-Status */
         switch(enumval) {
             case 1:
@@ -2871,7 +3627,7 @@ static char *interpret_enum(wandder_etsispec_t *etsidec, wandder_item_t *item,
                 break;
         }
     }
-    else if (item->identifier == 17 && curr == &(etsidec->emailiri)) {
+    else if (item->identifier == 17 && curr == &(etsidec->dumpers->emailiri)) {
         /* e-mail-Sender-Validity */
         switch(enumval) {
             case 0:
@@ -2882,7 +3638,7 @@ static char *interpret_enum(wandder_etsispec_t *etsidec, wandder_item_t *item,
                 break;
         }
     }
-    else if (item->identifier == 1 && curr == &(etsidec->emailcc)) {
+    else if (item->identifier == 1 && curr == &(etsidec->dumpers->emailcc)) {
         /* e-mail-Sender-Validity */
         switch(enumval) {
             case 1:
@@ -2893,8 +3649,8 @@ static char *interpret_enum(wandder_etsispec_t *etsidec, wandder_item_t *item,
                 break;
         }
     } else if (
-            (item->identifier == 2 && curr == &(etsidec->pop3aaainformation)) ||
-            (item->identifier == 4 && curr == &(etsidec->asmtpaaainformation)))
+            (item->identifier == 2 && curr == &(etsidec->dumpers->pop3aaainformation)) ||
+            (item->identifier == 4 && curr == &(etsidec->dumpers->asmtpaaainformation)))
     {
         /* aAAResult */
         switch(enumval) {
@@ -2909,7 +3665,7 @@ static char *interpret_enum(wandder_etsispec_t *etsidec, wandder_item_t *item,
                 break;
         }
     } else if (item->identifier == 1 &&
-            curr == &(etsidec->asmtpaaainformation)) {
+            curr == &(etsidec->dumpers->asmtpaaainformation)) {
         /* AAAauthMethod */
         switch(enumval) {
             case 1:
@@ -2928,7 +3684,7 @@ static char *interpret_enum(wandder_etsispec_t *etsidec, wandder_item_t *item,
 	 * Adding encryptionType and encryptedPayloadType, WPvS
 	 *
 	 */
-    else if (item->identifier == 0 && curr == &(etsidec->encryptioncontainer)) {
+    else if (item->identifier == 0 && curr == &(etsidec->dumpers->encryptioncontainer)) {
         /* EncryptionType */
         switch(enumval) {
             case 1:
@@ -2958,7 +3714,7 @@ static char *interpret_enum(wandder_etsispec_t *etsidec, wandder_item_t *item,
         etsidec->encrypt_method = enumval;
     }
 
-    else if (item->identifier == 2 && curr == &(etsidec->encryptioncontainer)) {
+    else if (item->identifier == 2 && curr == &(etsidec->dumpers->encryptioncontainer)) {
         /* EncryptionPayloadType */
         switch(enumval) {
             case 1:
@@ -2986,7 +3742,7 @@ static char *interpret_enum(wandder_etsispec_t *etsidec, wandder_item_t *item,
                 name = "part1";
                 break;
         }
-    } else if (item->identifier == 20 && curr == &(etsidec->epsiri_params)) {
+    } else if (item->identifier == 20 && curr == &(etsidec->dumpers->epsiri_params)) {
         /* ePSEvent */
         switch(enumval) {
             case 1:
@@ -3141,7 +3897,7 @@ static char *interpret_enum(wandder_etsispec_t *etsidec, wandder_item_t *item,
                 break;
 
         }
-    } else if (item->identifier == 29 && curr == &(etsidec->epsiri_params)) {
+    } else if (item->identifier == 29 && curr == &(etsidec->dumpers->epsiri_params)) {
         /* iMSEvent */
         switch(enumval) {
             case 1:
@@ -3181,7 +3937,7 @@ static char *interpret_enum(wandder_etsispec_t *etsidec, wandder_item_t *item,
                 name = "locationInformationRequest";
                 break;
         }
-    } else if (item->identifier == 34 && curr == &(etsidec->epsiri_params)) {
+    } else if (item->identifier == 34 && curr == &(etsidec->dumpers->epsiri_params)) {
         /* ldiEvent */
         switch(enumval) {
             case 1:
@@ -3192,7 +3948,7 @@ static char *interpret_enum(wandder_etsispec_t *etsidec, wandder_item_t *item,
                 break;
         }
     } else if ((item->identifier == 10 || item->identifier == 21)
-            && curr == &(etsidec->eps_gtpv2_params)) {
+            && curr == &(etsidec->dumpers->eps_gtpv2_params)) {
         /* typeOfBearer */
         switch(enumval) {
             case 1:
@@ -3202,7 +3958,7 @@ static char *interpret_enum(wandder_etsispec_t *etsidec, wandder_item_t *item,
                 name = "dedicatedBearer";
                 break;
         }
-    } else if (item->identifier == 6 && curr == &(etsidec->ulic_header)) {
+    } else if (item->identifier == 6 && curr == &(etsidec->dumpers->ulic_header)) {
         /* TPDU-direction */
         switch(enumval) {
             case 1:
@@ -3215,7 +3971,7 @@ static char *interpret_enum(wandder_etsispec_t *etsidec, wandder_item_t *item,
                 name = "unknown";
                 break;
         }
-    } else if (item->identifier == 8 && curr == &(etsidec->ulic_header)) {
+    } else if (item->identifier == 8 && curr == &(etsidec->dumpers->ulic_header)) {
         /* ICE-type */
         switch(enumval) {
             case 1:
@@ -3247,7 +4003,7 @@ static char *interpret_enum(wandder_etsispec_t *etsidec, wandder_item_t *item,
     return NULL;
 }
 
-static void free_dumpers(wandder_etsispec_t *dec) {
+static void free_dumpers(wandder_etsi_dumpers_t *dec) {
     free(dec->ipvalue.members);
     free(dec->timestamp.members);
     free(dec->localtimestamp.members);
@@ -3314,7 +4070,7 @@ static void free_dumpers(wandder_etsispec_t *dec) {
 
 }
 
-static void init_dumpers(wandder_etsispec_t *dec) {
+static void init_dumpers(wandder_etsi_dumpers_t *dec) {
 
     size_t i;
 
@@ -3324,12 +4080,14 @@ static void init_dumpers(wandder_etsispec_t *dec) {
     dec->ipvalue.members[1] =
         (struct wandder_dump_action) {
                 .name = "iPBinaryAddress",
+                .fieldid = WANDDER_ETSILI_FIELD_iPBinaryAddress,
                 .descend = NULL,
                 .interpretas = WANDDER_TAG_BINARY_IP
         };
     dec->ipvalue.members[2] =
         (struct wandder_dump_action) {
                 .name = "iPTextAddress",
+                .fieldid = WANDDER_ETSILI_FIELD_iPTextAddress,
                 .descend = NULL,
                 .interpretas = WANDDER_TAG_IA5
         };
@@ -3341,30 +4099,35 @@ static void init_dumpers(wandder_etsispec_t *dec) {
     dec->ipaddress.members[1] =
         (struct wandder_dump_action) {
                 .name = "iP-type",
+                .fieldid = WANDDER_ETSILI_FIELD_iP_type,
                 .descend = NULL,
                 .interpretas = WANDDER_TAG_ENUM
         };
     dec->ipaddress.members[2] =
         (struct wandder_dump_action) {
                 .name = "iP-value",
+                .fieldid = WANDDER_ETSILI_FIELD_iP_value,
                 .descend = &dec->ipvalue,
                 .interpretas = WANDDER_TAG_NULL
         };
     dec->ipaddress.members[3] =
         (struct wandder_dump_action) {
                 .name = "iP-assignment",
+                .fieldid = WANDDER_ETSILI_FIELD_iP_assignment,
                 .descend = NULL,
                 .interpretas = WANDDER_TAG_ENUM
         };
     dec->ipaddress.members[4] =
         (struct wandder_dump_action) {
                 .name = "iPv6PrefixLength",
+                .fieldid = WANDDER_ETSILI_FIELD_iPv6PrefixLength,
                 .descend = NULL,
                 .interpretas = WANDDER_TAG_INTEGER
         };
     dec->ipaddress.members[5] =
         (struct wandder_dump_action) {
                 .name = "iPv4SubnetMask",
+                .fieldid = WANDDER_ETSILI_FIELD_iPv4SubnetMask,
                 .descend = NULL,
                 .interpretas = WANDDER_TAG_BINARY_IP
         };
@@ -3376,6 +4139,7 @@ static void init_dumpers(wandder_etsispec_t *dec) {
     dec->datanodeaddress.members[1] =
         (struct wandder_dump_action) {
                 .name = "ipAddress",
+                .fieldid = WANDDER_ETSILI_FIELD_ipAddress,
                 .descend = &(dec->ipaddress),
                 .interpretas = WANDDER_TAG_NULL
         };
@@ -3387,6 +4151,7 @@ static void init_dumpers(wandder_etsispec_t *dec) {
     dec->nationalipmmiri.members[0] =
         (struct wandder_dump_action) {
                 .name = "countryCode",
+                .fieldid = WANDDER_ETSILI_FIELD_countryCode,
                 .descend = NULL,
                 .interpretas = WANDDER_TAG_PRINTABLE
         };
@@ -3397,12 +4162,14 @@ static void init_dumpers(wandder_etsispec_t *dec) {
     dec->localtimestamp.members[0] =
         (struct wandder_dump_action) {
                 .name = "generalizedTime",
+                .fieldid = WANDDER_ETSILI_FIELD_generalizedTime,
                 .descend = NULL,
                 .interpretas = WANDDER_TAG_GENERALTIME
         };
     dec->localtimestamp.members[1] =
         (struct wandder_dump_action) {
                 .name = "winterSummerIndication",
+                .fieldid = WANDDER_ETSILI_FIELD_winterSummerIndication,
                 .descend = NULL,
                 .interpretas = WANDDER_TAG_ENUM
         };
@@ -3413,12 +4180,14 @@ static void init_dumpers(wandder_etsispec_t *dec) {
     dec->timestamp.members[0] =
         (struct wandder_dump_action) {
                 .name = "localTime",
+                .fieldid = WANDDER_ETSILI_FIELD_localTime,
                 .descend = &(dec->localtimestamp),
                 .interpretas = WANDDER_TAG_NULL
         };
     dec->timestamp.members[1] =
         (struct wandder_dump_action) {
                 .name = "utcTime",
+                .fieldid = WANDDER_ETSILI_FIELD_utcTime,
                 .descend = NULL,
                 .interpretas = WANDDER_TAG_UTCTIME
         };
@@ -3429,24 +4198,28 @@ static void init_dumpers(wandder_etsispec_t *dec) {
     dec->h323content.members[0] =
         (struct wandder_dump_action) {
                 .name = "h225CSMessageContent",
+                .fieldid = WANDDER_ETSILI_FIELD_h225CSMessageContent,
                 .descend = NULL,
                 .interpretas = WANDDER_TAG_OCTETSTRING
         };
     dec->h323content.members[1] =
         (struct wandder_dump_action) {
                 .name = "h225RASMessageContent",
+                .fieldid = WANDDER_ETSILI_FIELD_h225RASMessageContent,
                 .descend = NULL,
                 .interpretas = WANDDER_TAG_OCTETSTRING
         };
     dec->h323content.members[2] =
         (struct wandder_dump_action) {
                 .name = "h245MessageContent",
+                .fieldid = WANDDER_ETSILI_FIELD_h245MessageContent,
                 .descend = NULL,
                 .interpretas = WANDDER_TAG_OCTETSTRING
         };
     dec->h323content.members[3] =
         (struct wandder_dump_action) {
                 .name = "genericMessageContent",
+                .fieldid = WANDDER_ETSILI_FIELD_genericMessageContent,
                 .descend = NULL,
                 .interpretas = WANDDER_TAG_OCTETSTRING
         };
@@ -3457,18 +4230,21 @@ static void init_dumpers(wandder_etsispec_t *dec) {
     dec->h323message.members[0] =
         (struct wandder_dump_action) {
                 .name = "ipSourceAddress",
+                .fieldid = WANDDER_ETSILI_FIELD_ipSourceAddress,
                 .descend = &dec->ipaddress,
                 .interpretas = WANDDER_TAG_NULL
         };
     dec->h323message.members[1] =
         (struct wandder_dump_action) {
                 .name = "ipDestinationAddress",
+                .fieldid = WANDDER_ETSILI_FIELD_ipDestinationAddress,
                 .descend = &dec->ipaddress,
                 .interpretas = WANDDER_TAG_NULL
         };
     dec->h323message.members[2] =
         (struct wandder_dump_action) {
                 .name = "h323Content",
+                .fieldid = WANDDER_ETSILI_FIELD_h323Content,
                 .descend = &dec->h323content,
                 .interpretas = WANDDER_TAG_NULL
         };
@@ -3479,18 +4255,21 @@ static void init_dumpers(wandder_etsispec_t *dec) {
     dec->sipmessage.members[0] =
         (struct wandder_dump_action) {
                 .name = "ipSourceAddress",
+                .fieldid = WANDDER_ETSILI_FIELD_ipSourceAddress,
                 .descend = &dec->ipaddress,
                 .interpretas = WANDDER_TAG_NULL
         };
     dec->sipmessage.members[1] =
         (struct wandder_dump_action) {
                 .name = "ipDestinationAddress",
+                .fieldid = WANDDER_ETSILI_FIELD_ipDestinationAddress,
                 .descend = &dec->ipaddress,
                 .interpretas = WANDDER_TAG_NULL
         };
     dec->sipmessage.members[2] =
         (struct wandder_dump_action) {
                 .name = "sIPContent",
+                .fieldid = WANDDER_ETSILI_FIELD_sIPContent,
                 .descend = NULL,
                 .interpretas = WANDDER_TAG_IPPACKET
         };
@@ -3501,24 +4280,28 @@ static void init_dumpers(wandder_etsispec_t *dec) {
     dec->ipmmiricontents.members[0] =
         (struct wandder_dump_action) {
                 .name = "originalIPMMMessage",
+                .fieldid = WANDDER_ETSILI_FIELD_originalIPMMMessage,
                 .descend = NULL,
                 .interpretas = WANDDER_TAG_IPPACKET
         };
     dec->ipmmiricontents.members[1] =
         (struct wandder_dump_action) {
                 .name = "sIPMessage",
+                .fieldid = WANDDER_ETSILI_FIELD_sIPMessage,
                 .descend = &dec->sipmessage,
                 .interpretas = WANDDER_TAG_NULL
         };
     dec->ipmmiricontents.members[2] =
         (struct wandder_dump_action) {
                 .name = "h323Message",
+                .fieldid = WANDDER_ETSILI_FIELD_h323Message,
                 .descend = &dec->h323message,
                 .interpretas = WANDDER_TAG_NULL
         };
     dec->ipmmiricontents.members[3] =
         (struct wandder_dump_action) {
                 .name = "nationalIPMMIRIParameters",
+                .fieldid = WANDDER_ETSILI_FIELD_nationalIPMMIRIParameters,
                 .descend = &dec->nationalipmmiri,
                 .interpretas = WANDDER_TAG_NULL
         };
@@ -3529,24 +4312,28 @@ static void init_dumpers(wandder_etsispec_t *dec) {
     dec->ipmmiri.members[0] =
         (struct wandder_dump_action) {
                 .name = "iPMMIRIObjId",
+                .fieldid = WANDDER_ETSILI_FIELD_iPMMIRIObjId,
                 .descend = NULL,
                 .interpretas = WANDDER_TAG_RELATIVEOID
         };
     dec->ipmmiri.members[1] =
         (struct wandder_dump_action) {
                 .name = "iPMMIRIContents",
+                .fieldid = WANDDER_ETSILI_FIELD_iPMMIRIContents,
                 .descend = &dec->ipmmiricontents,
                 .interpretas = WANDDER_TAG_NULL
         };
     dec->ipmmiri.members[2] =
         (struct wandder_dump_action) {
                 .name = "targetLocation",
+                .fieldid = WANDDER_ETSILI_FIELD_targetLocation,
                 .descend = &dec->lipspdulocation,
                 .interpretas = WANDDER_TAG_NULL
         };
     dec->ipmmiri.members[3] =
         (struct wandder_dump_action) {
                 .name = "additionalSignalingSeq",
+                .fieldid = WANDDER_ETSILI_FIELD_additionalSignalingSeq,
                 .descend = &dec->additionalsignallingseq,
                 .interpretas = WANDDER_TAG_NULL
         };
@@ -3557,30 +4344,35 @@ static void init_dumpers(wandder_etsispec_t *dec) {
     dec->lipspdulocation.members[0] =
         (struct wandder_dump_action) {
                 .name = "umtsHI2Location",
+                .fieldid = WANDDER_ETSILI_FIELD_umtsHI2Location,
                 .descend = NULL,
                 .interpretas = WANDDER_TAG_NULL
         };
     dec->lipspdulocation.members[1] =
         (struct wandder_dump_action) {
                 .name = "epsLocation",
+                .fieldid = WANDDER_ETSILI_FIELD_epsLocation,
                 .descend = &dec->epslocation,
                 .interpretas = WANDDER_TAG_NULL
         };
     dec->lipspdulocation.members[2] =
         (struct wandder_dump_action) {
                 .name = "wlanLocationAttributes",
+                .fieldid = WANDDER_ETSILI_FIELD_wlanLocationAttributes,
                 .descend = NULL,
                 .interpretas = WANDDER_TAG_NULL
         };
     dec->lipspdulocation.members[3] =
         (struct wandder_dump_action) {
                 .name = "eTSI671HI2Location",
+                .fieldid = WANDDER_ETSILI_FIELD_eTSI671HI2Location,
                 .descend = NULL,
                 .interpretas = WANDDER_TAG_NULL
         };
     dec->lipspdulocation.members[4] =
         (struct wandder_dump_action) {
                 .name = "threeGPP33128UserLocation",
+                .fieldid = WANDDER_ETSILI_FIELD_threeGPP33128UserLocation,
                 .descend = NULL,
                 .interpretas = WANDDER_TAG_NULL
         };
@@ -3592,60 +4384,70 @@ static void init_dumpers(wandder_etsispec_t *dec) {
     dec->epslocation.members[1] =
         (struct wandder_dump_action) {
                 .name = "userLocationInfo",
+                .fieldid = WANDDER_ETSILI_FIELD_userLocationInfo,
                 .descend = NULL,
                 .interpretas = WANDDER_TAG_ULI
         };
     dec->epslocation.members[2] =
         (struct wandder_dump_action) {
                 .name = "gsmLocation",
+                .fieldid = WANDDER_ETSILI_FIELD_gsmLocation,
                 .descend = NULL,
                 .interpretas = WANDDER_TAG_NULL
         };
     dec->epslocation.members[3] =
         (struct wandder_dump_action) {
                 .name = "umtsLocation",
+                .fieldid = WANDDER_ETSILI_FIELD_umtsLocation,
                 .descend = NULL,
                 .interpretas = WANDDER_TAG_NULL
         };
     dec->epslocation.members[4] =
         (struct wandder_dump_action) {
                 .name = "olduserLocationInfo",
+                .fieldid = WANDDER_ETSILI_FIELD_olduserLocationInfo,
                 .descend = NULL,
                 .interpretas = WANDDER_TAG_ULI
         };
     dec->epslocation.members[5] =
         (struct wandder_dump_action) {
                 .name = "lastVisitedTAI",
+                .fieldid = WANDDER_ETSILI_FIELD_lastVisitedTAI,
                 .descend = NULL,
                 .interpretas = WANDDER_TAG_TAI
         };
     dec->epslocation.members[6] =
         (struct wandder_dump_action) {
                 .name = "tAIlist",
+                .fieldid = WANDDER_ETSILI_FIELD_tAIlist,
                 .descend = NULL,
                 .interpretas = WANDDER_TAG_NULL
         };
     dec->epslocation.members[7] =
         (struct wandder_dump_action) {
                 .name = "threeGPP2Bsid",
+                .fieldid = WANDDER_ETSILI_FIELD_threeGPP2Bsid,
                 .descend = NULL,
                 .interpretas = WANDDER_TAG_OCTETSTRING
         };
     dec->epslocation.members[8] =
         (struct wandder_dump_action) {
                 .name = "civicAddress",
+                .fieldid = WANDDER_ETSILI_FIELD_civicAddress,
                 .descend = NULL,
                 .interpretas = WANDDER_TAG_NULL
         };
     dec->epslocation.members[9] =
         (struct wandder_dump_action) {
                 .name = "operatorSpecificInfo",
+                .fieldid = WANDDER_ETSILI_FIELD_operatorSpecificInfo,
                 .descend = NULL,
                 .interpretas = WANDDER_TAG_OCTETSTRING
         };
     dec->epslocation.members[10] =
         (struct wandder_dump_action) {
                 .name = "uELocationTimestamp",
+                .fieldid = WANDDER_ETSILI_FIELD_uELocationTimestamp,
                 .descend = NULL,
                 .interpretas = WANDDER_TAG_NULL
         };
@@ -3656,6 +4458,7 @@ static void init_dumpers(wandder_etsispec_t *dec) {
     dec->additionalsignallingseq.sequence =
         (struct wandder_dump_action) {
             .name = "additionalSignalling",
+            .fieldid = WANDDER_ETSILI_FIELD_additionalSignalling,
             .descend = &dec->additionalsignalling,
             .interpretas = WANDDER_TAG_NULL
         };
@@ -3665,6 +4468,7 @@ static void init_dumpers(wandder_etsispec_t *dec) {
     dec->additionalsignalling.members[0] =
         (struct wandder_dump_action) {
                 .name = "sipHeaderLine",
+                .fieldid = WANDDER_ETSILI_FIELD_sipHeaderLine,
                 .descend = NULL,
                 .interpretas = WANDDER_TAG_OCTETSTRING
         };
@@ -3674,6 +4478,7 @@ static void init_dumpers(wandder_etsispec_t *dec) {
     dec->ipcccontents.members[0] =
         (struct wandder_dump_action) {
                 .name = "iPPackets",
+                .fieldid = WANDDER_ETSILI_FIELD_iPPackets,
                 .descend = NULL,
                 .interpretas = WANDDER_TAG_IPPACKET
         };
@@ -3685,12 +4490,14 @@ static void init_dumpers(wandder_etsispec_t *dec) {
     dec->ipcc.members[0] =
         (struct wandder_dump_action) {
                 .name = "iPCCObjId",
+                .fieldid = WANDDER_ETSILI_FIELD_iPCCObjId,
                 .descend = NULL,
                 .interpretas = WANDDER_TAG_RELATIVEOID
         };
     dec->ipcc.members[1] =
         (struct wandder_dump_action) {
                 .name = "iPCCContents",
+                .fieldid = WANDDER_ETSILI_FIELD_iPCCContents,
                 .descend = &dec->ipcccontents,
                 .interpretas = WANDDER_TAG_NULL
         };
@@ -3702,12 +4509,14 @@ static void init_dumpers(wandder_etsispec_t *dec) {
     dec->epscc.members[1] =
         (struct wandder_dump_action) {
                 .name = "uLIC-header",
+                .fieldid = WANDDER_ETSILI_FIELD_uLIC_header,
                 .descend = &dec->ulic_header,
                 .interpretas = WANDDER_TAG_NULL
         };
     dec->epscc.members[2] =
         (struct wandder_dump_action) {
                 .name = "payload",
+                .fieldid = WANDDER_ETSILI_FIELD_payload,
                 .descend = NULL,
                 .interpretas = WANDDER_TAG_IPPACKET
         };
@@ -3718,6 +4527,7 @@ static void init_dumpers(wandder_etsispec_t *dec) {
     dec->ulic_header.members[0] =
         (struct wandder_dump_action) {
                 .name = "hi3DomainId",
+                .fieldid = WANDDER_ETSILI_FIELD_hi3DomainId,
                 .descend = NULL,
                 .interpretas = WANDDER_TAG_OID
         };
@@ -3725,30 +4535,35 @@ static void init_dumpers(wandder_etsispec_t *dec) {
     dec->ulic_header.members[2] =
         (struct wandder_dump_action) {
                 .name = "lIID",
+                .fieldid = WANDDER_ETSILI_FIELD_lIID,
                 .descend = NULL,
                 .interpretas = WANDDER_TAG_OCTETSTRING
         };
     dec->ulic_header.members[3] =
         (struct wandder_dump_action) {
                 .name = "correlation-Number",
+                .fieldid = WANDDER_ETSILI_FIELD_correlation_Number,
                 .descend = NULL,
                 .interpretas = WANDDER_TAG_OCTETSTRING
         };
     dec->ulic_header.members[4] =
         (struct wandder_dump_action) {
                 .name = "timeStamp",
+                .fieldid = WANDDER_ETSILI_FIELD_timeStamp,
                 .descend = &(dec->timestamp),
                 .interpretas = WANDDER_TAG_NULL
         };
     dec->ulic_header.members[5] =
         (struct wandder_dump_action) {
                 .name = "sequence-number",
+                .fieldid = WANDDER_ETSILI_FIELD_sequence_number,
                 .descend = NULL,
                 .interpretas = WANDDER_TAG_INTEGER
         };
     dec->ulic_header.members[6] =
         (struct wandder_dump_action) {
                 .name = "t-PDU-direction",
+                .fieldid = WANDDER_ETSILI_FIELD_t_PDU_direction,
                 .descend = NULL,
                 .interpretas = WANDDER_TAG_ENUM
         };
@@ -3757,6 +4572,7 @@ static void init_dumpers(wandder_etsispec_t *dec) {
     dec->ulic_header.members[8] =
         (struct wandder_dump_action) {
                 .name = "ice-type",
+                .fieldid = WANDDER_ETSILI_FIELD_ice_type,
                 .descend = NULL,
                 .interpretas = WANDDER_TAG_ENUM
         };
@@ -3767,30 +4583,35 @@ static void init_dumpers(wandder_etsispec_t *dec) {
     dec->ipmmcc.members[0] =
         (struct wandder_dump_action) {
                 .name = "iPMMCCObjId",
+                .fieldid = WANDDER_ETSILI_FIELD_iPMMCCObjId,
                 .descend = NULL,
                 .interpretas = WANDDER_TAG_RELATIVEOID
         };
     dec->ipmmcc.members[1] =
         (struct wandder_dump_action) {
                 .name = "mMCCContents",
+                .fieldid = WANDDER_ETSILI_FIELD_mMCCContents,
                 .descend = NULL,
                 .interpretas = WANDDER_TAG_IPPACKET
         };
     dec->ipmmcc.members[2] =
         (struct wandder_dump_action) {
                 .name = "frameType",
+                .fieldid = WANDDER_ETSILI_FIELD_frameType,
                 .descend = NULL,
                 .interpretas = WANDDER_TAG_ENUM
         };
     dec->ipmmcc.members[3] =
         (struct wandder_dump_action) {
                 .name = "streamIdentifier",
+                .fieldid = WANDDER_ETSILI_FIELD_streamIdentifier,
                 .descend = NULL,
                 .interpretas = WANDDER_TAG_OCTETSTRING
         };
     dec->ipmmcc.members[4] =
         (struct wandder_dump_action) {
                 .name = "mMCCprotocol",
+                .fieldid = WANDDER_ETSILI_FIELD_mMCCprotocol,
                 .descend = NULL,
                 .interpretas = WANDDER_TAG_ENUM
         };
@@ -3804,30 +4625,35 @@ static void init_dumpers(wandder_etsispec_t *dec) {
     dec->netelid.members[1] =
         (struct wandder_dump_action) {
                 .name = "e164-Format",
+                .fieldid = WANDDER_ETSILI_FIELD_e164_Format,
                 .descend = NULL,
                 .interpretas = WANDDER_TAG_OCTETSTRING
         };
     dec->netelid.members[2] =
         (struct wandder_dump_action) {
                 .name = "x25-Format",
+                .fieldid = WANDDER_ETSILI_FIELD_x25_Format,
                 .descend = NULL,
                 .interpretas = WANDDER_TAG_OCTETSTRING
         };
     dec->netelid.members[3] =
         (struct wandder_dump_action) {
                 .name = "iP-Format",
+                .fieldid = WANDDER_ETSILI_FIELD_iP_Format,
                 .descend = NULL,
                 .interpretas = WANDDER_TAG_OCTETSTRING
         };
     dec->netelid.members[4] =
         (struct wandder_dump_action) {
                 .name = "dNS-Format",
+                .fieldid = WANDDER_ETSILI_FIELD_dNS_Format,
                 .descend = NULL,
                 .interpretas = WANDDER_TAG_OCTETSTRING
         };
     dec->netelid.members[5] =        // TODO
         (struct wandder_dump_action) {
                 .name = "iP-Address",
+                .fieldid = WANDDER_ETSILI_FIELD_iP_Address,
                 .descend = &dec->ipaddress,
                 .interpretas = WANDDER_TAG_NULL
         };
@@ -3838,6 +4664,7 @@ static void init_dumpers(wandder_etsispec_t *dec) {
     dec->root.sequence =
         (struct wandder_dump_action) {
                 .name = "pS-PDU",
+                .fieldid = WANDDER_ETSILI_FIELD_pS_PDU,
                 .descend = &dec->pspdu,
                 .interpretas = WANDDER_TAG_NULL
         };
@@ -3847,18 +4674,21 @@ static void init_dumpers(wandder_etsispec_t *dec) {
     dec->linetid.members[0] =
         (struct wandder_dump_action) {
                 .name = "operatorIdentifier",
+                .fieldid = WANDDER_ETSILI_FIELD_operatorIdentifier,
                 .descend = NULL,
                 .interpretas = WANDDER_TAG_OCTETSTRING
         };
     dec->linetid.members[1] =
         (struct wandder_dump_action) {
                 .name = "networkElementIdentifier",
+                .fieldid = WANDDER_ETSILI_FIELD_networkElementIdentifier,
                 .descend = NULL,
                 .interpretas = WANDDER_TAG_OCTETSTRING
         };
     dec->linetid.members[2] =
         (struct wandder_dump_action) {
                 .name = "eTSI671NEID",
+                .fieldid = WANDDER_ETSILI_FIELD_eTSI671NEID,
                 .descend = &dec->netelid,
                 .interpretas = WANDDER_TAG_NULL
         };
@@ -3869,12 +4699,14 @@ static void init_dumpers(wandder_etsispec_t *dec) {
     dec->networkidentifier.members[0] =
         (struct wandder_dump_action) {
                 .name = "operator-Identifier",
+                .fieldid = WANDDER_ETSILI_FIELD_operator_Identifier,
                 .descend = NULL,
                 .interpretas = WANDDER_TAG_OCTETSTRING
         };
     dec->networkidentifier.members[1] =
         (struct wandder_dump_action) {
                 .name = "network-Element-Identifier",
+                .fieldid = WANDDER_ETSILI_FIELD_network_Element_Identifier,
                 .descend = &(dec->netelid),
                 .interpretas = WANDDER_TAG_NULL
         };
@@ -3885,12 +4717,14 @@ static void init_dumpers(wandder_etsispec_t *dec) {
     dec->hi2op_cid.members[0] =
         (struct wandder_dump_action) {
                 .name = "communication-Identity-Number",
+                .fieldid = WANDDER_ETSILI_FIELD_communication_Identity_Number,
                 .descend = NULL,
                 .interpretas = WANDDER_TAG_OCTETSTRING
         };
     dec->hi2op_cid.members[1] =
         (struct wandder_dump_action) {
                 .name = "network-Identifier",
+                .fieldid = WANDDER_ETSILI_FIELD_network_Identifier,
                 .descend = &(dec->hi2op_netid),
                 .interpretas = WANDDER_TAG_NULL
         };
@@ -3900,12 +4734,14 @@ static void init_dumpers(wandder_etsispec_t *dec) {
     dec->hi2op_netid.members[0] =
         (struct wandder_dump_action) {
                 .name = "operator-Identifier",
+                .fieldid = WANDDER_ETSILI_FIELD_operator_Identifier,
                 .descend = NULL,
                 .interpretas = WANDDER_TAG_OCTETSTRING
         };
     dec->hi2op_netid.members[1] =
         (struct wandder_dump_action) {
                 .name = "network-Element-Identifier",
+                .fieldid = WANDDER_ETSILI_FIELD_network_Element_Identifier,
                 .descend = &(dec->netelid),
                 .interpretas = WANDDER_TAG_NULL
         };
@@ -3916,18 +4752,21 @@ static void init_dumpers(wandder_etsispec_t *dec) {
     dec->cid.members[0] =
         (struct wandder_dump_action) {
                 .name = "networkIdentifier",
+                .fieldid = WANDDER_ETSILI_FIELD_networkIdentifier,
                 .descend = &dec->linetid,
                 .interpretas = WANDDER_TAG_NULL
         };
     dec->cid.members[1] =
         (struct wandder_dump_action) {
                 .name = "communicationIdentityNumber",
+                .fieldid = WANDDER_ETSILI_FIELD_communicationIdentityNumber,
                 .descend = NULL,
                 .interpretas = WANDDER_TAG_INTEGER
         };
     dec->cid.members[2] =
         (struct wandder_dump_action) {
                 .name = "deliveryCountryCode",
+                .fieldid = WANDDER_ETSILI_FIELD_deliveryCountryCode,
                 .descend = NULL,
                 .interpretas = WANDDER_TAG_PRINTABLE
         };
@@ -3938,12 +4777,14 @@ static void init_dumpers(wandder_etsispec_t *dec) {
     dec->msts.members[0] =
         (struct wandder_dump_action) {
                 .name = "seconds",
+                .fieldid = WANDDER_ETSILI_FIELD_seconds,
                 .descend = NULL,
                 .interpretas = WANDDER_TAG_INTEGER
         };
     dec->msts.members[1] =
         (struct wandder_dump_action) {
                 .name = "microSeconds",
+                .fieldid = WANDDER_ETSILI_FIELD_microSeconds,
                 .descend = NULL,
                 .interpretas = WANDDER_TAG_INTEGER
         };
@@ -3955,12 +4796,14 @@ static void init_dumpers(wandder_etsispec_t *dec) {
     dec->cccontents.members[1] =     // TODO
         (struct wandder_dump_action) {
                 .name = "emailCC",
+                .fieldid = WANDDER_ETSILI_FIELD_emailCC,
                 .descend = &(dec->emailcc),
                 .interpretas = WANDDER_TAG_NULL
         };
     dec->cccontents.members[2] =
         (struct wandder_dump_action) {
                 .name = "iPCC",
+                .fieldid = WANDDER_ETSILI_FIELD_iPCC,
                 .descend = &dec->ipcc,
                 .interpretas = WANDDER_TAG_NULL
         };
@@ -3968,6 +4811,7 @@ static void init_dumpers(wandder_etsispec_t *dec) {
     dec->cccontents.members[4] =
         (struct wandder_dump_action) {
                 .name = "uMTSCC",
+                .fieldid = WANDDER_ETSILI_FIELD_uMTSCC,
                 .descend = NULL,
                 .interpretas = WANDDER_TAG_IPPACKET
         };
@@ -3981,6 +4825,7 @@ static void init_dumpers(wandder_etsispec_t *dec) {
     dec->cccontents.members[12] =
         (struct wandder_dump_action) {
                 .name = "iPMMCC",
+                .fieldid = WANDDER_ETSILI_FIELD_iPMMCC,
                 .descend = &dec->ipmmcc,
                 .interpretas = WANDDER_TAG_NULL
         };
@@ -3991,6 +4836,7 @@ static void init_dumpers(wandder_etsispec_t *dec) {
     dec->cccontents.members[17] =
         (struct wandder_dump_action) {
                 .name = "ePSCC",
+                .fieldid = WANDDER_ETSILI_FIELD_ePSCC,
                 .descend = &dec->epscc,
                 .interpretas = WANDDER_TAG_NULL
         };
@@ -4002,30 +4848,35 @@ static void init_dumpers(wandder_etsispec_t *dec) {
     dec->ccpayload.members[0] =
         (struct wandder_dump_action) {
                 .name = "payloadDirection",
+                .fieldid = WANDDER_ETSILI_FIELD_payloadDirection,
                 .descend = NULL,
                 .interpretas = WANDDER_TAG_ENUM
         };
     dec->ccpayload.members[1] =
         (struct wandder_dump_action) {
                 .name = "timeStamp",
+                .fieldid = WANDDER_ETSILI_FIELD_timeStamp,
                 .descend = NULL,
                 .interpretas = WANDDER_TAG_GENERALTIME
         };
     dec->ccpayload.members[2] =
         (struct wandder_dump_action) {
                 .name = "cCContents",
+                .fieldid = WANDDER_ETSILI_FIELD_cCContents,
                 .descend = &dec->cccontents,
                 .interpretas = WANDDER_TAG_NULL
         };
     dec->ccpayload.members[3] =
         (struct wandder_dump_action) {
                 .name = "microSecondTimestamp",
+                .fieldid = WANDDER_ETSILI_FIELD_microSecondTimestamp,
                 .descend = &dec->msts,
                 .interpretas = WANDDER_TAG_NULL
         };
     dec->ccpayload.members[4] =
         (struct wandder_dump_action) {
                 .name = "timeStampQualifier",
+                .fieldid = WANDDER_ETSILI_FIELD_timeStampQualifier,
                 .descend = NULL,
                 .interpretas = WANDDER_TAG_ENUM
         };
@@ -4036,6 +4887,7 @@ static void init_dumpers(wandder_etsispec_t *dec) {
     dec->ccpayloadseq.sequence =
         (struct wandder_dump_action) {
                 .name = "CCPayload",
+                .fieldid = WANDDER_ETSILI_FIELD_CCPayload,
                 .descend = &dec->ccpayload,
                 .interpretas = WANDDER_TAG_NULL
         };
@@ -4045,12 +4897,14 @@ static void init_dumpers(wandder_etsispec_t *dec) {
     dec->operatorleamessage.members[0] =
         (struct wandder_dump_action) {
                 .name = "messagePriority",
+                .fieldid = WANDDER_ETSILI_FIELD_messagePriority,
                 .descend = NULL,
                 .interpretas = WANDDER_TAG_ENUM
         };
     dec->operatorleamessage.members[1] =
         (struct wandder_dump_action) {
                 .name = "message",
+                .fieldid = WANDDER_ETSILI_FIELD_message,
                 .descend = NULL,
                 .interpretas = WANDDER_TAG_OCTETSTRING
         };
@@ -4060,30 +4914,35 @@ static void init_dumpers(wandder_etsispec_t *dec) {
     dec->integritycheck.members[0] =
         (struct wandder_dump_action) {
                 .name = "includedSequenceNumbers",
+                .fieldid = WANDDER_ETSILI_FIELD_includedSequenceNumbers,
                 .descend = NULL,
                 .interpretas = WANDDER_TAG_INTEGER_SEQUENCE
         };
     dec->integritycheck.members[1] =
         (struct wandder_dump_action) {
                 .name = "checkType",
+                .fieldid = WANDDER_ETSILI_FIELD_checkType,
                 .descend = NULL,
                 .interpretas = WANDDER_TAG_ENUM
         };
     dec->integritycheck.members[2] =
         (struct wandder_dump_action) {
                 .name = "dataType",
+                .fieldid = WANDDER_ETSILI_FIELD_dataType,
                 .descend = NULL,
                 .interpretas = WANDDER_TAG_ENUM
         };
     dec->integritycheck.members[3] =
         (struct wandder_dump_action) {
                 .name = "checkValue",
+                .fieldid = WANDDER_ETSILI_FIELD_checkValue,
                 .descend = NULL,
                 .interpretas = WANDDER_TAG_HEX_BYTES
         };
     dec->integritycheck.members[4] =
         (struct wandder_dump_action) {
                 .name = "hashAlgorithm",
+                .fieldid = WANDDER_ETSILI_FIELD_hashAlgorithm,
                 .descend = NULL,
                 .interpretas = WANDDER_TAG_ENUM
         };
@@ -4093,6 +4952,7 @@ static void init_dumpers(wandder_etsispec_t *dec) {
     dec->option.members[0] =
         (struct wandder_dump_action) {
                 .name = "pDUAcknowledgement",
+                .fieldid = WANDDER_ETSILI_FIELD_pDUAcknowledgement,
                 .descend = NULL,
                 .interpretas = WANDDER_TAG_NULL
         };
@@ -4103,6 +4963,7 @@ static void init_dumpers(wandder_etsispec_t *dec) {
     dec->optionseq.sequence =
         (struct wandder_dump_action) {
                 .name = "Option",
+                .fieldid = WANDDER_ETSILI_FIELD_Option,
                 .descend = &(dec->option),
                 .interpretas = WANDDER_TAG_NULL
         };
@@ -4112,6 +4973,7 @@ static void init_dumpers(wandder_etsispec_t *dec) {
     dec->optionreq.members[0] =
         (struct wandder_dump_action) {
                 .name = "requestedOptions",
+                .fieldid = WANDDER_ETSILI_FIELD_requestedOptions,
                 .descend = &(dec->optionseq),
                 .interpretas = WANDDER_TAG_NULL
         };
@@ -4121,12 +4983,14 @@ static void init_dumpers(wandder_etsispec_t *dec) {
     dec->optionresp.members[0] =
         (struct wandder_dump_action) {
                 .name = "acceptedOptions",
+                .fieldid = WANDDER_ETSILI_FIELD_acceptedOptions,
                 .descend = &(dec->optionseq),
                 .interpretas = WANDDER_TAG_NULL
         };
     dec->optionresp.members[1] =
         (struct wandder_dump_action) {
                 .name = "declinedOptions",
+                .fieldid = WANDDER_ETSILI_FIELD_declinedOptions,
                 .descend = &(dec->optionseq),
                 .interpretas = WANDDER_TAG_NULL
         };
@@ -4136,24 +5000,28 @@ static void init_dumpers(wandder_etsispec_t *dec) {
     dec->hi1notification.members[0] =
         (struct wandder_dump_action) {
                 .name = "domainID",
+                .fieldid = WANDDER_ETSILI_FIELD_domainID,
                 .descend = NULL,
                 .interpretas = WANDDER_TAG_OID
         };
     dec->hi1notification.members[1] =
         (struct wandder_dump_action) {
                 .name = "lawfulInterceptionIdentifier",
+                .fieldid = WANDDER_ETSILI_FIELD_lawfulInterceptionIdentifier,
                 .descend = NULL,
                 .interpretas = WANDDER_TAG_OCTETSTRING
         };
     dec->hi1notification.members[2] =
         (struct wandder_dump_action) {
                 .name = "communicationIdentifier",
+                .fieldid = WANDDER_ETSILI_FIELD_communicationIdentifier,
                 .descend = &(dec->hi2op_cid),
                 .interpretas = WANDDER_TAG_NULL
         };
     dec->hi1notification.members[3] =
         (struct wandder_dump_action) {
                 .name = "timeStamp",
+                .fieldid = WANDDER_ETSILI_FIELD_timeStamp,
                 .descend = &(dec->timestamp),
                 .interpretas = WANDDER_TAG_NULL
         };
@@ -4161,12 +5029,14 @@ static void init_dumpers(wandder_etsispec_t *dec) {
     dec->hi1notification.members[5] =
         (struct wandder_dump_action) {
                 .name = "national-HI1-ASN1parameters",
+                .fieldid = WANDDER_ETSILI_FIELD_national_HI1_ASN1parameters,
                 .descend = NULL,
                 .interpretas = WANDDER_TAG_NULL
         };
     dec->hi1notification.members[6] =
         (struct wandder_dump_action) {
                 .name = "target-Information",
+                .fieldid = WANDDER_ETSILI_FIELD_target_Information,
                 .descend = NULL,
                 .interpretas = WANDDER_TAG_OCTETSTRING
         };
@@ -4177,30 +5047,35 @@ static void init_dumpers(wandder_etsispec_t *dec) {
     dec->hi1operation.members[1] =
         (struct wandder_dump_action) {
                 .name = "liActivated",
+                .fieldid = WANDDER_ETSILI_FIELD_liActivated,
                 .descend = &(dec->hi1notification),
                 .interpretas = WANDDER_TAG_NULL
         };
     dec->hi1operation.members[2] =
         (struct wandder_dump_action) {
                 .name = "liDeactivated",
+                .fieldid = WANDDER_ETSILI_FIELD_liDeactivated,
                 .descend = &(dec->hi1notification),
                 .interpretas = WANDDER_TAG_NULL
         };
     dec->hi1operation.members[3] =
         (struct wandder_dump_action) {
                 .name = "liModified",
+                .fieldid = WANDDER_ETSILI_FIELD_liModified,
                 .descend = &(dec->hi1notification),
                 .interpretas = WANDDER_TAG_NULL
         };
     dec->hi1operation.members[4] =
         (struct wandder_dump_action) {
                 .name = "alarams-indicator",
+                .fieldid = WANDDER_ETSILI_FIELD_alarams_indicator,
                 .descend = NULL,
                 .interpretas = WANDDER_TAG_NULL
         };
     dec->hi1operation.members[5] =
         (struct wandder_dump_action) {
                 .name = "national-HI1-ASN1parameters",
+                .fieldid = WANDDER_ETSILI_FIELD_national_HI1_ASN1parameters,
                 .descend = NULL,
                 .interpretas = WANDDER_TAG_NULL
         };
@@ -4211,84 +5086,98 @@ static void init_dumpers(wandder_etsispec_t *dec) {
     dec->tripayload.members[0] =
         (struct wandder_dump_action) {
                 .name = "integrityCheck",
+                .fieldid = WANDDER_ETSILI_FIELD_integrityCheck,
                 .descend = &(dec->integritycheck),
                 .interpretas = WANDDER_TAG_NULL
         };
     dec->tripayload.members[1] =
         (struct wandder_dump_action) {
                 .name = "testPDU",
+                .fieldid = WANDDER_ETSILI_FIELD_testPDU,
                 .descend = NULL,
                 .interpretas = WANDDER_TAG_NULL
         };
     dec->tripayload.members[2] =
         (struct wandder_dump_action) {
                 .name = "paddingPDU",
+                .fieldid = WANDDER_ETSILI_FIELD_paddingPDU,
                 .descend = NULL,
                 .interpretas = WANDDER_TAG_OCTETSTRING
         };
     dec->tripayload.members[3] =
         (struct wandder_dump_action) {
                 .name = "keep-alive",
+                .fieldid = WANDDER_ETSILI_FIELD_keep_alive,
                 .descend = NULL,
                 .interpretas = WANDDER_TAG_NULL
         };
     dec->tripayload.members[4] =
         (struct wandder_dump_action) {
                 .name = "keep-aliveResponse",
+                .fieldid = WANDDER_ETSILI_FIELD_keep_aliveResponse,
                 .descend = NULL,
                 .interpretas = WANDDER_TAG_NULL
         };
     dec->tripayload.members[5] =
         (struct wandder_dump_action) {
                 .name = "firstSegmentFlag",
+                .fieldid = WANDDER_ETSILI_FIELD_firstSegmentFlag,
                 .descend = NULL,
                 .interpretas = WANDDER_TAG_NULL
         };
     dec->tripayload.members[6] =
         (struct wandder_dump_action) {
                 .name = "lastSegmentFlag",
+                .fieldid = WANDDER_ETSILI_FIELD_lastSegmentFlag,
                 .descend = NULL,
                 .interpretas = WANDDER_TAG_NULL
         };
     dec->tripayload.members[7] =
         (struct wandder_dump_action) {
                 .name = "cINReset",
+                .fieldid = WANDDER_ETSILI_FIELD_cINReset,
                 .descend = NULL,
                 .interpretas = WANDDER_TAG_NULL
         };
     dec->tripayload.members[8] =
         (struct wandder_dump_action) {
                 .name = "operatorLeaMessage",
+                .fieldid = WANDDER_ETSILI_FIELD_operatorLeaMessage,
                 .descend = &(dec->operatorleamessage),
                 .interpretas = WANDDER_TAG_NULL
         };
     dec->tripayload.members[9] =
         (struct wandder_dump_action) {
                 .name = "optionRequest",
+                .fieldid = WANDDER_ETSILI_FIELD_optionRequest,
                 .descend = &(dec->optionreq),
                 .interpretas = WANDDER_TAG_NULL
         };
     dec->tripayload.members[10] =
         (struct wandder_dump_action) {
                 .name = "optionResponse",
+                .fieldid = WANDDER_ETSILI_FIELD_optionResponse,
                 .descend = &(dec->optionresp),
                 .interpretas = WANDDER_TAG_NULL
         };
     dec->tripayload.members[11] =
         (struct wandder_dump_action) {
                 .name = "optionComplete",
+                .fieldid = WANDDER_ETSILI_FIELD_optionComplete,
                 .descend = NULL,
                 .interpretas = WANDDER_TAG_NULL
         };
     dec->tripayload.members[12] =
         (struct wandder_dump_action) {
                 .name = "pDUAcknowledgementRequest",
+                .fieldid = WANDDER_ETSILI_FIELD_pDUAcknowledgementRequest,
                 .descend = NULL,
                 .interpretas = WANDDER_TAG_NULL
         };
     dec->tripayload.members[13] =
         (struct wandder_dump_action) {
                 .name = "pDUAcknowledgementResponse",
+                .fieldid = WANDDER_ETSILI_FIELD_pDUAcknowledgementResponse,
                 .descend = NULL,
                 .interpretas = WANDDER_TAG_NULL
         };
@@ -4299,18 +5188,21 @@ static void init_dumpers(wandder_etsispec_t *dec) {
     dec->ipiriid.members[0] =
         (struct wandder_dump_action) {
                 .name = "printableIDType",
+                .fieldid = WANDDER_ETSILI_FIELD_printableIDType,
                 .descend = NULL,
                 .interpretas = WANDDER_TAG_UTF8STR
         };
     dec->ipiriid.members[1] =
         (struct wandder_dump_action) {
                 .name = "macAddressType",
+                .fieldid = WANDDER_ETSILI_FIELD_macAddressType,
                 .descend = NULL,
                 .interpretas = WANDDER_TAG_OCTETSTRING
         };
     dec->ipiriid.members[2] =
         (struct wandder_dump_action) {
                 .name = "ipAddressType",
+                .fieldid = WANDDER_ETSILI_FIELD_ipAddressType,
                 .descend = &dec->ipaddress,
                 .interpretas = WANDDER_TAG_NULL
         };
@@ -4324,30 +5216,35 @@ static void init_dumpers(wandder_etsispec_t *dec) {
     dec->gprsparams.members[1] =
         (struct wandder_dump_action) {
                 .name = "pDP-address-allocated-to-the-target",
+                .fieldid = WANDDER_ETSILI_FIELD_pDP_address_allocated_to_the_target,
                 .descend = &(dec->datanodeaddress),
                 .interpretas = WANDDER_TAG_NULL
         };
     dec->gprsparams.members[2] =
         (struct wandder_dump_action) {
                 .name = "aPN",
+                .fieldid = WANDDER_ETSILI_FIELD_aPN,
                 .descend = NULL,
                 .interpretas = WANDDER_TAG_DOMAIN_NAME
         };
     dec->gprsparams.members[3] =
         (struct wandder_dump_action) {
                 .name = "pDP-type",
+                .fieldid = WANDDER_ETSILI_FIELD_pDP_type,
                 .descend = NULL,
                 .interpretas = WANDDER_TAG_HEX_BYTES
         };
     dec->gprsparams.members[4] =
         (struct wandder_dump_action) {
                 .name = "nSAPI",
+                .fieldid = WANDDER_ETSILI_FIELD_nSAPI,
                 .descend = NULL,
                 .interpretas = WANDDER_TAG_OCTETSTRING
         };
     dec->gprsparams.members[5] =
         (struct wandder_dump_action) {
                 .name = "additionalIPaddress",
+                .fieldid = WANDDER_ETSILI_FIELD_additionalIPaddress,
                 .descend = &(dec->datanodeaddress),
                 .interpretas = WANDDER_TAG_NULL
         };
@@ -4360,6 +5257,7 @@ static void init_dumpers(wandder_etsispec_t *dec) {
     dec->servicesdatainfo.members[1] =
         (struct wandder_dump_action) {
                 .name = "gPRS-parameters",
+                .fieldid = WANDDER_ETSILI_FIELD_gPRS_parameters,
                 .descend = &dec->gprsparams,
                 .interpretas = WANDDER_TAG_NULL
         };
@@ -4373,6 +5271,7 @@ static void init_dumpers(wandder_etsispec_t *dec) {
     dec->partyidentity.members[1] =
         (struct wandder_dump_action) {
                 .name = "imei",
+                .fieldid = WANDDER_ETSILI_FIELD_imei,
                 .descend = NULL,
                 .interpretas = WANDDER_TAG_3G_IMEI
         };
@@ -4380,6 +5279,7 @@ static void init_dumpers(wandder_etsispec_t *dec) {
     dec->partyidentity.members[3] =
         (struct wandder_dump_action) {
                 .name = "imsi",
+                .fieldid = WANDDER_ETSILI_FIELD_imsi,
                 .descend = NULL,
                 .interpretas = WANDDER_TAG_3G_IMEI
         };
@@ -4388,36 +5288,42 @@ static void init_dumpers(wandder_etsispec_t *dec) {
     dec->partyidentity.members[6] =
         (struct wandder_dump_action) {
                 .name = "msISDN",
+                .fieldid = WANDDER_ETSILI_FIELD_msISDN,
                 .descend = NULL,
                 .interpretas = WANDDER_TAG_3G_IMEI
         };
     dec->partyidentity.members[7] =
         (struct wandder_dump_action) {
                 .name = "e164-Format",
+                .fieldid = WANDDER_ETSILI_FIELD_e164_Format,
                 .descend = NULL,
                 .interpretas = WANDDER_TAG_OCTETSTRING
         };
     dec->partyidentity.members[8] =
         (struct wandder_dump_action) {
                 .name = "sip-uri",
+                .fieldid = WANDDER_ETSILI_FIELD_sip_uri,
                 .descend = NULL,
                 .interpretas = WANDDER_TAG_OCTETSTRING
         };
     dec->partyidentity.members[9] =
         (struct wandder_dump_action) {
                 .name = "tel-uri",
+                .fieldid = WANDDER_ETSILI_FIELD_tel_uri,
                 .descend = NULL,
                 .interpretas = WANDDER_TAG_OCTETSTRING
         };
     dec->partyidentity.members[10] =
         (struct wandder_dump_action) {
                 .name = "x-3GPP-Asserted-Identity",
+                .fieldid = WANDDER_ETSILI_FIELD_x_3GPP_Asserted_Identity,
                 .descend = NULL,
                 .interpretas = WANDDER_TAG_OCTETSTRING
         };
     dec->partyidentity.members[11] =
         (struct wandder_dump_action) {
                 .name = "xUI",
+                .fieldid = WANDDER_ETSILI_FIELD_xUI,
                 .descend = NULL,
                 .interpretas = WANDDER_TAG_OCTETSTRING
         };
@@ -4430,12 +5336,14 @@ static void init_dumpers(wandder_etsispec_t *dec) {
     dec->partyinfo.members[0] =
         (struct wandder_dump_action) {
                 .name = "party-Qualifier",
+                .fieldid = WANDDER_ETSILI_FIELD_party_Qualifier,
                 .descend = NULL,
                 .interpretas = WANDDER_TAG_ENUM
         };
     dec->partyinfo.members[1] =
         (struct wandder_dump_action) {
                 .name = "partyIdentity",
+                .fieldid = WANDDER_ETSILI_FIELD_partyIdentity,
                 .descend = &dec->partyidentity,
                 .interpretas = WANDDER_TAG_NULL
         };
@@ -4444,6 +5352,7 @@ static void init_dumpers(wandder_etsispec_t *dec) {
     dec->partyinfo.members[4] =
         (struct wandder_dump_action) {
                 .name = "services-Data-Information",
+                .fieldid = WANDDER_ETSILI_FIELD_services_Data_Information,
                 .descend = &dec->servicesdatainfo,
                 .interpretas = WANDDER_TAG_NULL
         };
@@ -4457,12 +5366,14 @@ static void init_dumpers(wandder_etsispec_t *dec) {
     dec->location.members[1] =
         (struct wandder_dump_action) {
                 .name = "e164-Number",
+                .fieldid = WANDDER_ETSILI_FIELD_e164_Number,
                 .descend = NULL,
                 .interpretas = WANDDER_TAG_OCTETSTRING
         };
     dec->location.members[2] =
         (struct wandder_dump_action) {
                 .name = "globalCellID",
+                .fieldid = WANDDER_ETSILI_FIELD_globalCellID,
                 .descend = NULL,
                 .interpretas = WANDDER_TAG_CGI
         };
@@ -4470,6 +5381,7 @@ static void init_dumpers(wandder_etsispec_t *dec) {
     dec->location.members[4] =
         (struct wandder_dump_action) {
                 .name = "rAI",
+                .fieldid = WANDDER_ETSILI_FIELD_rAI,
                 .descend = NULL,
                 .interpretas = WANDDER_TAG_OCTETSTRING
         };
@@ -4478,24 +5390,28 @@ static void init_dumpers(wandder_etsispec_t *dec) {
     dec->location.members[7] =
         (struct wandder_dump_action) {
                 .name = "sAI",
+                .fieldid = WANDDER_ETSILI_FIELD_sAI,
                 .descend = NULL,
                 .interpretas = WANDDER_TAG_SAI
         };
     dec->location.members[8] =
         (struct wandder_dump_action) {
                 .name = "oldRAI",
+                .fieldid = WANDDER_ETSILI_FIELD_oldRAI,
                 .descend = NULL,
                 .interpretas = WANDDER_TAG_OCTETSTRING
         };
     dec->location.members[9] =
         (struct wandder_dump_action) {
                 .name = "tAI",
+                .fieldid = WANDDER_ETSILI_FIELD_tAI,
                 .descend = NULL,
                 .interpretas = WANDDER_TAG_TAI
         };
     dec->location.members[10] =
         (struct wandder_dump_action) {
                 .name = "eCGI",
+                .fieldid = WANDDER_ETSILI_FIELD_eCGI,
                 .descend = NULL,
                 .interpretas = WANDDER_TAG_ECGI
         };
@@ -4503,12 +5419,14 @@ static void init_dumpers(wandder_etsispec_t *dec) {
     dec->location.members[12] =
         (struct wandder_dump_action) {
                 .name = "operatorSpecificInfo",
+                .fieldid = WANDDER_ETSILI_FIELD_operatorSpecificInfo,
                 .descend = NULL,
                 .interpretas = WANDDER_TAG_OCTETSTRING
         };
     dec->location.members[13] =
         (struct wandder_dump_action) {
                 .name = "uELocationTimestamp",
+                .fieldid = WANDDER_ETSILI_FIELD_uELocationTimestamp,
                 .descend = &dec->timestamp,
                 .interpretas = WANDDER_TAG_NULL
         };
@@ -4521,12 +5439,14 @@ static void init_dumpers(wandder_etsispec_t *dec) {
     dec->umtsqos.members[1] =
         (struct wandder_dump_action) {
                 .name = "qosMobileRadio",
+                .fieldid = WANDDER_ETSILI_FIELD_qosMobileRadio,
                 .descend = NULL,
                 .interpretas = WANDDER_TAG_OCTETSTRING
         };
     dec->umtsqos.members[2] =
         (struct wandder_dump_action) {
                 .name = "qosGn",
+                .fieldid = WANDDER_ETSILI_FIELD_qosGn,
                 .descend = NULL,
                 .interpretas = WANDDER_TAG_OCTETSTRING
         };
@@ -4539,12 +5459,14 @@ static void init_dumpers(wandder_etsispec_t *dec) {
     dec->eps_protconfigoptions.members[1] =
         (struct wandder_dump_action) {
                 .name = "ueToNetwork",
+                .fieldid = WANDDER_ETSILI_FIELD_ueToNetwork,
                 .descend = NULL,
                 .interpretas = WANDDER_TAG_HEX_BYTES
         };
     dec->eps_protconfigoptions.members[2] =
         (struct wandder_dump_action) {
                 .name = "networkToUe",
+                .fieldid = WANDDER_ETSILI_FIELD_networkToUe,
                 .descend = NULL,
                 .interpretas = WANDDER_TAG_HEX_BYTES
         };
@@ -4560,6 +5482,7 @@ static void init_dumpers(wandder_etsispec_t *dec) {
     dec->eps_gtpv2_params.members[1] =
         (struct wandder_dump_action) {
                 .name = "pDNAddressAllocation",
+                .fieldid = WANDDER_ETSILI_FIELD_pDNAddressAllocation,
                 .descend = NULL,
                 .interpretas = WANDDER_TAG_HEX_BYTES
         };
@@ -4567,6 +5490,7 @@ static void init_dumpers(wandder_etsispec_t *dec) {
     dec->eps_gtpv2_params.members[2] =
         (struct wandder_dump_action) {
                 .name = "aPN",
+                .fieldid = WANDDER_ETSILI_FIELD_aPN,
                 .descend = NULL,
                 .interpretas = WANDDER_TAG_DOMAIN_NAME
         };
@@ -4574,6 +5498,7 @@ static void init_dumpers(wandder_etsispec_t *dec) {
     dec->eps_gtpv2_params.members[3] =
         (struct wandder_dump_action) {
                 .name = "protConfigOptions",
+                .fieldid = WANDDER_ETSILI_FIELD_protConfigOptions,
                 .descend = &(dec->eps_protconfigoptions),
                 .interpretas = WANDDER_TAG_NULL
         };
@@ -4581,6 +5506,7 @@ static void init_dumpers(wandder_etsispec_t *dec) {
     dec->eps_gtpv2_params.members[4] =
         (struct wandder_dump_action) {
                 .name = "attachType",
+                .fieldid = WANDDER_ETSILI_FIELD_attachType,
                 .descend = NULL,
                 .interpretas = WANDDER_TAG_EPS_ATTACH_TYPE
         };
@@ -4588,6 +5514,7 @@ static void init_dumpers(wandder_etsispec_t *dec) {
     dec->eps_gtpv2_params.members[5] =
         (struct wandder_dump_action) {
                 .name = "ePSBearerIdentity",
+                .fieldid = WANDDER_ETSILI_FIELD_ePSBearerIdentity,
                 .descend = NULL,
                 .interpretas = WANDDER_TAG_HEX_BYTES
         };
@@ -4595,6 +5522,7 @@ static void init_dumpers(wandder_etsispec_t *dec) {
     dec->eps_gtpv2_params.members[6] =
         (struct wandder_dump_action) {
                 .name = "detachType",
+                .fieldid = WANDDER_ETSILI_FIELD_detachType,
                 .descend = NULL,
                 .interpretas = WANDDER_TAG_HEX_BYTES
         };
@@ -4602,6 +5530,7 @@ static void init_dumpers(wandder_etsispec_t *dec) {
     dec->eps_gtpv2_params.members[7] =
         (struct wandder_dump_action) {
                 .name = "rATType",
+                .fieldid = WANDDER_ETSILI_FIELD_rATType,
                 .descend = NULL,
                 .interpretas = WANDDER_TAG_EPS_RAT_TYPE
         };
@@ -4609,6 +5538,7 @@ static void init_dumpers(wandder_etsispec_t *dec) {
     dec->eps_gtpv2_params.members[8] =
         (struct wandder_dump_action) {
                 .name = "failedBearerActivationReason",
+                .fieldid = WANDDER_ETSILI_FIELD_failedBearerActivationReason,
                 .descend = NULL,
                 .interpretas = WANDDER_TAG_EPS_CAUSE
         };
@@ -4616,6 +5546,7 @@ static void init_dumpers(wandder_etsispec_t *dec) {
     dec->eps_gtpv2_params.members[9] =
         (struct wandder_dump_action) {
                 .name = "ePSBearerQoS",
+                .fieldid = WANDDER_ETSILI_FIELD_ePSBearerQoS,
                 .descend = NULL,
                 .interpretas = WANDDER_TAG_HEX_BYTES
         };
@@ -4623,6 +5554,7 @@ static void init_dumpers(wandder_etsispec_t *dec) {
     dec->eps_gtpv2_params.members[10] =
         (struct wandder_dump_action) {
                 .name = "bearerActivationType",
+                .fieldid = WANDDER_ETSILI_FIELD_bearerActivationType,
                 .descend = NULL,
                 .interpretas = WANDDER_TAG_ENUM
         };
@@ -4630,6 +5562,7 @@ static void init_dumpers(wandder_etsispec_t *dec) {
     dec->eps_gtpv2_params.members[11] =
         (struct wandder_dump_action) {
                 .name = "aPN-AMBR",
+                .fieldid = WANDDER_ETSILI_FIELD_aPN_AMBR,
                 .descend = NULL,
                 .interpretas = WANDDER_TAG_EPS_APN_AMBR
         };
@@ -4637,6 +5570,7 @@ static void init_dumpers(wandder_etsispec_t *dec) {
     dec->eps_gtpv2_params.members[13] =
         (struct wandder_dump_action) {
                 .name = "linkedEPSBearerId",
+                .fieldid = WANDDER_ETSILI_FIELD_linkedEPSBearerId,
                 .descend = NULL,
                 .interpretas = WANDDER_TAG_HEX_BYTES
         };
@@ -4644,6 +5578,7 @@ static void init_dumpers(wandder_etsispec_t *dec) {
     dec->eps_gtpv2_params.members[16] =
         (struct wandder_dump_action) {
                 .name = "failedBearerModificationReason",
+                .fieldid = WANDDER_ETSILI_FIELD_failedBearerModificationReason,
                 .descend = NULL,
                 .interpretas = WANDDER_TAG_EPS_CAUSE
         };
@@ -4651,6 +5586,7 @@ static void init_dumpers(wandder_etsispec_t *dec) {
     dec->eps_gtpv2_params.members[21] =
         (struct wandder_dump_action) {
                 .name = "bearerDeactivationType",
+                .fieldid = WANDDER_ETSILI_FIELD_bearerDeactivationType,
                 .descend = NULL,
                 .interpretas = WANDDER_TAG_ENUM
         };
@@ -4658,6 +5594,7 @@ static void init_dumpers(wandder_etsispec_t *dec) {
     dec->eps_gtpv2_params.members[22] =
         (struct wandder_dump_action) {
                 .name = "bearerDeactivationCause",
+                .fieldid = WANDDER_ETSILI_FIELD_bearerDeactivationCause,
                 .descend = NULL,
                 .interpretas = WANDDER_TAG_EPS_CAUSE
         };
@@ -4665,6 +5602,7 @@ static void init_dumpers(wandder_etsispec_t *dec) {
     dec->eps_gtpv2_params.members[23] =
         (struct wandder_dump_action) {
                 .name = "ePSlocationOfTheTarget",
+                .fieldid = WANDDER_ETSILI_FIELD_ePSlocationOfTheTarget,
                 .descend = &(dec->epslocation),
                 .interpretas = WANDDER_TAG_NULL
         };
@@ -4672,6 +5610,7 @@ static void init_dumpers(wandder_etsispec_t *dec) {
     dec->eps_gtpv2_params.members[24] =
         (struct wandder_dump_action) {
                 .name = "pDNType",
+                .fieldid = WANDDER_ETSILI_FIELD_pDNType,
                 .descend = NULL,
                 .interpretas = WANDDER_TAG_EPS_PDN_TYPE
         };
@@ -4691,6 +5630,7 @@ static void init_dumpers(wandder_etsispec_t *dec) {
     dec->epsiri_params.members[0] =
         (struct wandder_dump_action) {
                 .name = "hi2epsDomainId",
+                .fieldid = WANDDER_ETSILI_FIELD_hi2epsDomainId,
                 .descend = NULL,
                 .interpretas = WANDDER_TAG_OID
         };
@@ -4698,6 +5638,7 @@ static void init_dumpers(wandder_etsispec_t *dec) {
     dec->epsiri_params.members[1] =
         (struct wandder_dump_action) {
                 .name = "lawfulInterceptionIdentifier",
+                .fieldid = WANDDER_ETSILI_FIELD_lawfulInterceptionIdentifier,
                 .descend = NULL,
                 .interpretas = WANDDER_TAG_OCTETSTRING
         };
@@ -4705,6 +5646,7 @@ static void init_dumpers(wandder_etsispec_t *dec) {
     dec->epsiri_params.members[3] =
         (struct wandder_dump_action) {
                 .name = "timeStamp",
+                .fieldid = WANDDER_ETSILI_FIELD_timeStamp,
                 .descend = &dec->timestamp,
                 .interpretas = WANDDER_TAG_NULL
         };
@@ -4712,6 +5654,7 @@ static void init_dumpers(wandder_etsispec_t *dec) {
     dec->epsiri_params.members[4] =
         (struct wandder_dump_action) {
                 .name = "initiator",
+                .fieldid = WANDDER_ETSILI_FIELD_initiator,
                 .descend = NULL,
                 .interpretas = WANDDER_TAG_ENUM
         };
@@ -4719,6 +5662,7 @@ static void init_dumpers(wandder_etsispec_t *dec) {
     dec->epsiri_params.members[8] =
         (struct wandder_dump_action) {
                 .name = "locationOfTheTarget",
+                .fieldid = WANDDER_ETSILI_FIELD_locationOfTheTarget,
                 .descend = &dec->location,
                 .interpretas = WANDDER_TAG_NULL
         };
@@ -4726,6 +5670,7 @@ static void init_dumpers(wandder_etsispec_t *dec) {
     dec->epsiri_params.members[9] =
         (struct wandder_dump_action) {
                 .name = "partyInformation",
+                .fieldid = WANDDER_ETSILI_FIELD_partyInformation,
                 .descend = &dec->partyinfo,
                 .interpretas = WANDDER_TAG_NULL
         };
@@ -4733,6 +5678,7 @@ static void init_dumpers(wandder_etsispec_t *dec) {
     dec->epsiri_params.members[13] =
         (struct wandder_dump_action) {
                 .name = "serviceCenterAddress",
+                .fieldid = WANDDER_ETSILI_FIELD_serviceCenterAddress,
                 .descend = &dec->partyinfo,
                 .interpretas = WANDDER_TAG_NULL
         };
@@ -4740,6 +5686,7 @@ static void init_dumpers(wandder_etsispec_t *dec) {
     dec->epsiri_params.members[18] =
         (struct wandder_dump_action) {
                 .name = "ePSCorrelationNumber",
+                .fieldid = WANDDER_ETSILI_FIELD_ePSCorrelationNumber,
                 .descend = NULL,
                 .interpretas = WANDDER_TAG_OCTETSTRING
         };
@@ -4747,6 +5694,7 @@ static void init_dumpers(wandder_etsispec_t *dec) {
     dec->epsiri_params.members[20] =
         (struct wandder_dump_action) {
                 .name = "ePSevent",
+                .fieldid = WANDDER_ETSILI_FIELD_ePSevent,
                 .descend = NULL,
                 .interpretas = WANDDER_TAG_ENUM
         };
@@ -4754,72 +5702,84 @@ static void init_dumpers(wandder_etsispec_t *dec) {
     dec->epsiri_params.members[21] =
         (struct wandder_dump_action) {
                 .name = "sgsnAddress",
+                .fieldid = WANDDER_ETSILI_FIELD_sgsnAddress,
                 .descend = &(dec->datanodeaddress),
                 .interpretas = WANDDER_TAG_NULL
         };
     dec->epsiri_params.members[22] =
         (struct wandder_dump_action) {
                 .name = "gPRSOperationErrorCode",
+                .fieldid = WANDDER_ETSILI_FIELD_gPRSOperationErrorCode,
                 .descend = NULL,
                 .interpretas = WANDDER_TAG_3G_SM_CAUSE
         };
     dec->epsiri_params.members[24] =
         (struct wandder_dump_action) {
                 .name = "ggsnAddress",
+                .fieldid = WANDDER_ETSILI_FIELD_ggsnAddress,
                 .descend = &(dec->datanodeaddress),
                 .interpretas = WANDDER_TAG_NULL
         };
     dec->epsiri_params.members[25] =
         (struct wandder_dump_action) {
                 .name = "qOS",
+                .fieldid = WANDDER_ETSILI_FIELD_qOS,
                 .descend = &(dec->umtsqos),
                 .interpretas = WANDDER_TAG_NULL
         };
     dec->epsiri_params.members[26] =
         (struct wandder_dump_action) {
                 .name = "networkIdentifier",
+                .fieldid = WANDDER_ETSILI_FIELD_networkIdentifier,
                 .descend = &(dec->networkidentifier),
                 .interpretas = WANDDER_TAG_NULL
         };
     dec->epsiri_params.members[27] =
         (struct wandder_dump_action) {
                 .name = "sMSOriginatingAddress",
+                .fieldid = WANDDER_ETSILI_FIELD_sMSOriginatingAddress,
                 .descend = &(dec->datanodeaddress),
                 .interpretas = WANDDER_TAG_NULL
         };
     dec->epsiri_params.members[28] =
         (struct wandder_dump_action) {
                 .name = "sMSTerminatingAddress",
+                .fieldid = WANDDER_ETSILI_FIELD_sMSTerminatingAddress,
                 .descend = &(dec->datanodeaddress),
                 .interpretas = WANDDER_TAG_NULL
         };
     dec->epsiri_params.members[29] =
         (struct wandder_dump_action) {
                 .name = "iMSevent",
+                .fieldid = WANDDER_ETSILI_FIELD_iMSevent,
                 .descend = NULL,
                 .interpretas = WANDDER_TAG_ENUM
         };
     dec->epsiri_params.members[30] =
         (struct wandder_dump_action) {
                 .name = "sIPMessage",
+                .fieldid = WANDDER_ETSILI_FIELD_sIPMessage,
                 .descend = NULL,
                 .interpretas = WANDDER_TAG_OCTETSTRING
         };
     dec->epsiri_params.members[31] =
         (struct wandder_dump_action) {
                 .name = "servingSGSN-number",
+                .fieldid = WANDDER_ETSILI_FIELD_servingSGSN_number,
                 .descend = NULL,
                 .interpretas = WANDDER_TAG_OCTETSTRING
         };
     dec->epsiri_params.members[32] =
         (struct wandder_dump_action) {
                 .name = "servingSGSN-address",
+                .fieldid = WANDDER_ETSILI_FIELD_servingSGSN_address,
                 .descend = NULL,
                 .interpretas = WANDDER_TAG_OCTETSTRING
         };
     dec->epsiri_params.members[34] =
         (struct wandder_dump_action) {
                 .name = "ldiEvent",
+                .fieldid = WANDDER_ETSILI_FIELD_ldiEvent,
                 .descend = NULL,
                 .interpretas = WANDDER_TAG_ENUM
         };
@@ -4827,6 +5787,7 @@ static void init_dumpers(wandder_etsispec_t *dec) {
     dec->epsiri_params.members[36] =
         (struct wandder_dump_action) {
                 .name = "ePS-GTPV2-specificParameters",
+                .fieldid = WANDDER_ETSILI_FIELD_ePS_GTPV2_specificParameters,
                 .descend = &(dec->eps_gtpv2_params),
                 .interpretas = WANDDER_TAG_NULL
         };
@@ -4844,12 +5805,14 @@ static void init_dumpers(wandder_etsispec_t *dec) {
     dec->umtsiri_params.members[0] =
         (struct wandder_dump_action) {
                 .name = "hi2DomainId",
+                .fieldid = WANDDER_ETSILI_FIELD_hi2DomainId,
                 .descend = NULL,
                 .interpretas = WANDDER_TAG_OID
         };
     dec->umtsiri_params.members[1] =
         (struct wandder_dump_action) {
                 .name = "lawfulInterceptionIdentifier",
+                .fieldid = WANDDER_ETSILI_FIELD_lawfulInterceptionIdentifier,
                 .descend = NULL,
                 .interpretas = WANDDER_TAG_OCTETSTRING
         };
@@ -4857,12 +5820,14 @@ static void init_dumpers(wandder_etsispec_t *dec) {
     dec->umtsiri_params.members[3] =
         (struct wandder_dump_action) {
                 .name = "timeStamp",
+                .fieldid = WANDDER_ETSILI_FIELD_timeStamp,
                 .descend = &dec->timestamp,
                 .interpretas = WANDDER_TAG_NULL
         };
     dec->umtsiri_params.members[4] =
         (struct wandder_dump_action) {
                 .name = "initiator",
+                .fieldid = WANDDER_ETSILI_FIELD_initiator,
                 .descend = NULL,
                 .interpretas = WANDDER_TAG_ENUM
         };
@@ -4872,12 +5837,14 @@ static void init_dumpers(wandder_etsispec_t *dec) {
     dec->umtsiri_params.members[8] =
         (struct wandder_dump_action) {
                 .name = "locationOfTheTarget",
+                .fieldid = WANDDER_ETSILI_FIELD_locationOfTheTarget,
                 .descend = &dec->location,
                 .interpretas = WANDDER_TAG_NULL
         };
     dec->umtsiri_params.members[9] =
         (struct wandder_dump_action) {
                 .name = "partyInformation",
+                .fieldid = WANDDER_ETSILI_FIELD_partyInformation,
                 .descend = &dec->partyinfo,
                 .interpretas = WANDDER_TAG_NULL
         };
@@ -4892,6 +5859,7 @@ static void init_dumpers(wandder_etsispec_t *dec) {
     dec->umtsiri_params.members[18] =
         (struct wandder_dump_action) {
                 .name = "gPRSCorrelationNumber",
+                .fieldid = WANDDER_ETSILI_FIELD_gPRSCorrelationNumber,
                 .descend = NULL,
                 .interpretas = WANDDER_TAG_OCTETSTRING
         };
@@ -4899,30 +5867,35 @@ static void init_dumpers(wandder_etsispec_t *dec) {
     dec->umtsiri_params.members[20] =
         (struct wandder_dump_action) {
                 .name = "gPRSevent",
+                .fieldid = WANDDER_ETSILI_FIELD_gPRSevent,
                 .descend = NULL,
                 .interpretas = WANDDER_TAG_ENUM
         };
     dec->umtsiri_params.members[21] =
         (struct wandder_dump_action) {
                 .name = "sgsnAddress",
+                .fieldid = WANDDER_ETSILI_FIELD_sgsnAddress,
                 .descend = &(dec->datanodeaddress),
                 .interpretas = WANDDER_TAG_NULL
         };
     dec->umtsiri_params.members[22] =
         (struct wandder_dump_action) {
                 .name = "gPRSOperationErrorCode",
+                .fieldid = WANDDER_ETSILI_FIELD_gPRSOperationErrorCode,
                 .descend = NULL,
                 .interpretas = WANDDER_TAG_3G_SM_CAUSE
         };
     dec->umtsiri_params.members[23] =
         (struct wandder_dump_action) {
                 .name = "iRIversion",
+                .fieldid = WANDDER_ETSILI_FIELD_iRIversion,
                 .descend = NULL,
                 .interpretas = WANDDER_TAG_ENUM
         };
     dec->umtsiri_params.members[24] =
         (struct wandder_dump_action) {
                 .name = "ggsnAddress",
+                .fieldid = WANDDER_ETSILI_FIELD_ggsnAddress,
                 .descend = &(dec->datanodeaddress),
                 .interpretas = WANDDER_TAG_NULL
         };
@@ -4930,6 +5903,7 @@ static void init_dumpers(wandder_etsispec_t *dec) {
     dec->umtsiri_params.members[26] =
         (struct wandder_dump_action) {
                 .name = "networkIdentifier",
+                .fieldid = WANDDER_ETSILI_FIELD_networkIdentifier,
                 .descend = &(dec->networkidentifier),
                 .interpretas = WANDDER_TAG_NULL
         };
@@ -4972,120 +5946,140 @@ static void init_dumpers(wandder_etsispec_t *dec) {
     dec->ipiricontents.members[0] =
         (struct wandder_dump_action) {
                 .name = "accessEventType",
+                .fieldid = WANDDER_ETSILI_FIELD_accessEventType,
                 .descend = NULL,
                 .interpretas = WANDDER_TAG_ENUM
         };
     dec->ipiricontents.members[1] =
         (struct wandder_dump_action) {
                 .name = "targetUsername",
+                .fieldid = WANDDER_ETSILI_FIELD_targetUsername,
                 .descend = NULL,
                 .interpretas = WANDDER_TAG_OCTETSTRING
         };
     dec->ipiricontents.members[2] =
         (struct wandder_dump_action) {
                 .name = "internetAccessType",
+                .fieldid = WANDDER_ETSILI_FIELD_internetAccessType,
                 .descend = NULL,
                 .interpretas = WANDDER_TAG_ENUM
         };
     dec->ipiricontents.members[3] =
         (struct wandder_dump_action) {
                 .name = "iPVersion",
+                .fieldid = WANDDER_ETSILI_FIELD_iPVersion,
                 .descend = NULL,
                 .interpretas = WANDDER_TAG_ENUM
         };
     dec->ipiricontents.members[4] =
         (struct wandder_dump_action) {
                 .name = "targetIPAddress",
+                .fieldid = WANDDER_ETSILI_FIELD_targetIPAddress,
                 .descend = &dec->ipaddress,
                 .interpretas = WANDDER_TAG_NULL
         };
     dec->ipiricontents.members[5] =
         (struct wandder_dump_action) {
                 .name = "targetNetworkID",
+                .fieldid = WANDDER_ETSILI_FIELD_targetNetworkID,
                 .descend = NULL,
                 .interpretas = WANDDER_TAG_UTF8STR
         };
     dec->ipiricontents.members[6] =
         (struct wandder_dump_action) {
                 .name = "targetCPEID",
+                .fieldid = WANDDER_ETSILI_FIELD_targetCPEID,
                 .descend = NULL,
                 .interpretas = WANDDER_TAG_UTF8STR
         };
     dec->ipiricontents.members[7] =
         (struct wandder_dump_action) {
                 .name = "targetLocation",
+                .fieldid = WANDDER_ETSILI_FIELD_targetLocation,
                 .descend = NULL,
                 .interpretas = WANDDER_TAG_UTF8STR
         };
     dec->ipiricontents.members[8] =
         (struct wandder_dump_action) {
                 .name = "pOPPortNumber",
+                .fieldid = WANDDER_ETSILI_FIELD_pOPPortNumber,
                 .descend = NULL,
                 .interpretas = WANDDER_TAG_INTEGER
         };
     dec->ipiricontents.members[9] =
         (struct wandder_dump_action) {
                 .name = "callBackNumber",
+                .fieldid = WANDDER_ETSILI_FIELD_callBackNumber,
                 .descend = NULL,
                 .interpretas = WANDDER_TAG_UTF8STR
         };
     dec->ipiricontents.members[10] =
         (struct wandder_dump_action) {
                 .name = "startTime",
+                .fieldid = WANDDER_ETSILI_FIELD_startTime,
                 .descend = NULL,
                 .interpretas = WANDDER_TAG_GENERALTIME
         };
     dec->ipiricontents.members[11] =
         (struct wandder_dump_action) {
                 .name = "endTime",
+                .fieldid = WANDDER_ETSILI_FIELD_endTime,
                 .descend = NULL,
                 .interpretas = WANDDER_TAG_GENERALTIME
         };
     dec->ipiricontents.members[12] =
         (struct wandder_dump_action) {
                 .name = "endReason",
+                .fieldid = WANDDER_ETSILI_FIELD_endReason,
                 .descend = NULL,
                 .interpretas = WANDDER_TAG_ENUM
         };
     dec->ipiricontents.members[13] =
         (struct wandder_dump_action) {
                 .name = "octetsReceived",
+                .fieldid = WANDDER_ETSILI_FIELD_octetsReceived,
                 .descend = NULL,
                 .interpretas = WANDDER_TAG_INTEGER
         };
     dec->ipiricontents.members[14] =
         (struct wandder_dump_action) {
                 .name = "octetsTransmitted",
+                .fieldid = WANDDER_ETSILI_FIELD_octetsTransmitted,
                 .descend = NULL,
                 .interpretas = WANDDER_TAG_INTEGER
         };
     dec->ipiricontents.members[15] =
         (struct wandder_dump_action) {
                 .name = "rawAAAData",
+                .fieldid = WANDDER_ETSILI_FIELD_rawAAAData,
                 .descend = NULL,
                 .interpretas = WANDDER_TAG_OCTETSTRING
         };
     dec->ipiricontents.members[16] =
         (struct wandder_dump_action) {
                 .name = "expectedEndTime",
+                .fieldid = WANDDER_ETSILI_FIELD_expectedEndTime,
                 .descend = NULL,
                 .interpretas = WANDDER_TAG_GENERALTIME
         };
     dec->ipiricontents.members[17] =
         (struct wandder_dump_action) {
                 .name = "pOPPhoneNumber",
+                .fieldid = WANDDER_ETSILI_FIELD_pOPPhoneNumber,
                 .descend = NULL,
                 .interpretas = WANDDER_TAG_UTF8STR
         };
     dec->ipiricontents.members[18] =
         (struct wandder_dump_action) {
                 .name = "pOPIdentifier",
+                .fieldid = WANDDER_ETSILI_FIELD_pOPIdentifier,
                 .descend = &dec->ipiriid,
                 .interpretas = WANDDER_TAG_NULL
         };
     dec->ipiricontents.members[19] =
         (struct wandder_dump_action) {
                 .name = "pOPIPAddress",
+                .fieldid = WANDDER_ETSILI_FIELD_pOPIPAddress,
                 .descend = &dec->ipaddress,
                 .interpretas = WANDDER_TAG_NULL
         };
@@ -5093,12 +6087,14 @@ static void init_dumpers(wandder_etsispec_t *dec) {
     dec->ipiricontents.members[21] =
         (struct wandder_dump_action) {
                 .name = "additionalIPAddress",
+                .fieldid = WANDDER_ETSILI_FIELD_additionalIPAddress,
                 .descend = &dec->ipaddress,
                 .interpretas = WANDDER_TAG_NULL
         };
     dec->ipiricontents.members[22] =
         (struct wandder_dump_action) {
                 .name = "authenticationType",
+                .fieldid = WANDDER_ETSILI_FIELD_authenticationType,
                 .descend = NULL,
                 .interpretas = WANDDER_TAG_ENUM
         };
@@ -5110,12 +6106,14 @@ static void init_dumpers(wandder_etsispec_t *dec) {
     dec->ipiri.members[0] =
         (struct wandder_dump_action) {
                 .name = "iPIRIObjId",
+                .fieldid = WANDDER_ETSILI_FIELD_iPIRIObjId,
                 .descend = NULL,
                 .interpretas = WANDDER_TAG_RELATIVEOID
         };
     dec->ipiri.members[1] =
         (struct wandder_dump_action) {
                 .name = "iPIRIContents",
+                .fieldid = WANDDER_ETSILI_FIELD_iPIRIContents,
                 .descend = &dec->ipiricontents,
                 .interpretas = WANDDER_TAG_NULL
         };
@@ -5128,6 +6126,7 @@ static void init_dumpers(wandder_etsispec_t *dec) {
     dec->umtsiri.members[0] =
         (struct wandder_dump_action) {
                 .name = "iRI-Parameters",
+                .fieldid = WANDDER_ETSILI_FIELD_iRI_Parameters,
                 .descend = &(dec->umtsiri_params),
                 .interpretas = WANDDER_TAG_NULL
         };
@@ -5141,6 +6140,7 @@ static void init_dumpers(wandder_etsispec_t *dec) {
     dec->epsiri.members[0] =
         (struct wandder_dump_action) {
                 .name = "iRI-EPS-Parameters",
+                .fieldid = WANDDER_ETSILI_FIELD_iRI_EPS_Parameters,
                 .descend = &(dec->epsiri_params),
                 .interpretas = WANDDER_TAG_NULL
         };
@@ -5152,18 +6152,21 @@ static void init_dumpers(wandder_etsispec_t *dec) {
     dec->emailcc.members[0] =
         (struct wandder_dump_action) {
                 .name = "emailCCObjId",
+                .fieldid = WANDDER_ETSILI_FIELD_emailCCObjId,
                 .descend = NULL,
                 .interpretas = WANDDER_TAG_RELATIVEOID
         };
     dec->emailcc.members[1] =
         (struct wandder_dump_action) {
                 .name = "email-Format",
+                .fieldid = WANDDER_ETSILI_FIELD_email_Format,
                 .descend = NULL,
                 .interpretas = WANDDER_TAG_ENUM
         };
     dec->emailcc.members[2] =
         (struct wandder_dump_action) {
                 .name = "email-Content",
+                .fieldid = WANDDER_ETSILI_FIELD_email_Content,
                 .descend = NULL,
                 .interpretas = WANDDER_TAG_IPPACKET
         };
@@ -5173,108 +6176,126 @@ static void init_dumpers(wandder_etsispec_t *dec) {
     dec->emailiri.members[0] =
         (struct wandder_dump_action) {
                 .name = "emailIRIObjId",
+                .fieldid = WANDDER_ETSILI_FIELD_emailIRIObjId,
                 .descend = NULL,
                 .interpretas = WANDDER_TAG_RELATIVEOID
         };
     dec->emailiri.members[1] =
         (struct wandder_dump_action) {
                 .name = "eventType",
+                .fieldid = WANDDER_ETSILI_FIELD_eventType,
                 .descend = NULL,
                 .interpretas = WANDDER_TAG_ENUM
         };
     dec->emailiri.members[2] =
         (struct wandder_dump_action) {
                 .name = "client-Address",
+                .fieldid = WANDDER_ETSILI_FIELD_client_Address,
                 .descend = (&dec->ipaddress),
                 .interpretas = WANDDER_TAG_NULL
         };
     dec->emailiri.members[3] =
         (struct wandder_dump_action) {
                 .name = "server-Address",
+                .fieldid = WANDDER_ETSILI_FIELD_server_Address,
                 .descend = (&dec->ipaddress),
                 .interpretas = WANDDER_TAG_NULL
         };
     dec->emailiri.members[4] =
         (struct wandder_dump_action) {
                 .name = "client-Port",
+                .fieldid = WANDDER_ETSILI_FIELD_client_Port,
                 .descend = NULL,
                 .interpretas = WANDDER_TAG_INTEGER
         };
     dec->emailiri.members[5] =
         (struct wandder_dump_action) {
                 .name = "server-Port",
+                .fieldid = WANDDER_ETSILI_FIELD_server_Port,
                 .descend = NULL,
                 .interpretas = WANDDER_TAG_INTEGER
         };
     dec->emailiri.members[6] =
         (struct wandder_dump_action) {
                 .name = "server-Octets-Sent",
+                .fieldid = WANDDER_ETSILI_FIELD_server_Octets_Sent,
                 .descend = NULL,
                 .interpretas = WANDDER_TAG_INTEGER
         };
     dec->emailiri.members[7] =
         (struct wandder_dump_action) {
                 .name = "client-Octets-Sent",
+                .fieldid = WANDDER_ETSILI_FIELD_client_Octets_Sent,
                 .descend = NULL,
                 .interpretas = WANDDER_TAG_INTEGER
         };
     dec->emailiri.members[8] =
         (struct wandder_dump_action) {
                 .name = "protocol-ID",
+                .fieldid = WANDDER_ETSILI_FIELD_protocol_ID,
                 .descend = NULL,
                 .interpretas = WANDDER_TAG_ENUM
         };
     dec->emailiri.members[9] =
         (struct wandder_dump_action) {
                 .name = "e-mail-Sender",
+                .fieldid = WANDDER_ETSILI_FIELD_e_mail_Sender,
                 .descend = NULL,
                 .interpretas = WANDDER_TAG_UTF8STR
         };
     dec->emailiri.members[10] =
         (struct wandder_dump_action) {
                 .name = "e-mail-Recipients",
+                .fieldid = WANDDER_ETSILI_FIELD_e_mail_Recipients,
                 .descend = &(dec->emailrecipients),
                 .interpretas = WANDDER_TAG_NULL
         };
     dec->emailiri.members[11] =
         (struct wandder_dump_action) {
                 .name = "status",
+                .fieldid = WANDDER_ETSILI_FIELD_status,
                 .descend = NULL,
                 .interpretas = WANDDER_TAG_ENUM
         };
     dec->emailiri.members[12] =
         (struct wandder_dump_action) {
                 .name = "total-Recipient-Count",
+                .fieldid = WANDDER_ETSILI_FIELD_total_Recipient_Count,
                 .descend = NULL,
                 .interpretas = WANDDER_TAG_INTEGER
         };
     dec->emailiri.members[13] =
         (struct wandder_dump_action) {
                 .name = "message-ID",
+                .fieldid = WANDDER_ETSILI_FIELD_message_ID,
                 .descend = NULL,
                 .interpretas = WANDDER_TAG_OCTETSTRING
         };
     dec->emailiri.members[14] =
         (struct wandder_dump_action) {
                 .name = "nationalParameter",
+                .fieldid = WANDDER_ETSILI_FIELD_nationalParameter,
                 .descend = NULL,
                 .interpretas = WANDDER_TAG_OCTETSTRING
         };
     dec->emailiri.members[15] =
         (struct wandder_dump_action) {
                 .name = "national-EM-ASN1parameters",
+                .fieldid = WANDDER_ETSILI_FIELD_national_EM_ASN1parameters,
                 .descend = NULL,
                 .interpretas = WANDDER_TAG_NULL
         };
     dec->emailiri.members[16] =
         (struct wandder_dump_action) {
                 .name = "aAAInformation",
+                .fieldid = WANDDER_ETSILI_FIELD_aAAInformation,
                 .descend = &(dec->aaainformation),
                 .interpretas = WANDDER_TAG_NULL
         };
     dec->emailiri.members[17] =
         (struct wandder_dump_action) {
                 .name = "e-mail-Sender-Validity",
+                .fieldid = WANDDER_ETSILI_FIELD_e_mail_Sender_Validity,
                 .descend = NULL,
                 .interpretas = WANDDER_TAG_ENUM
         };
@@ -5285,6 +6306,7 @@ static void init_dumpers(wandder_etsispec_t *dec) {
     dec->emailrecipients.sequence =
         (struct wandder_dump_action) {
                 .name = "recipient",
+                .fieldid = WANDDER_ETSILI_FIELD_recipient,
                 .descend = NULL,
                 .interpretas = WANDDER_TAG_UTF8STR
         };
@@ -5294,18 +6316,21 @@ static void init_dumpers(wandder_etsispec_t *dec) {
     dec->aaainformation.members[0] =
         (struct wandder_dump_action) {
                 .name = "pOP3AAAInformation",
+                .fieldid = WANDDER_ETSILI_FIELD_pOP3AAAInformation,
                 .descend = &(dec->pop3aaainformation),
                 .interpretas = WANDDER_TAG_NULL
         };
     dec->aaainformation.members[1] =
         (struct wandder_dump_action) {
                 .name = "aSMTPAAAInformation",
+                .fieldid = WANDDER_ETSILI_FIELD_aSMTPAAAInformation,
                 .descend = &(dec->asmtpaaainformation),
                 .interpretas = WANDDER_TAG_NULL
         };
     dec->aaainformation.members[2] =
         (struct wandder_dump_action) {
                 .name = "iMAPAAAInformation",
+                .fieldid = WANDDER_ETSILI_FIELD_iMAPAAAInformation,
                 // not an error! uses the same sequence structure as pop3!
                 .descend = &(dec->pop3aaainformation),
                 .interpretas = WANDDER_TAG_NULL
@@ -5317,18 +6342,21 @@ static void init_dumpers(wandder_etsispec_t *dec) {
     dec->pop3aaainformation.members[0] =
         (struct wandder_dump_action) {
                 .name = "username",
+                .fieldid = WANDDER_ETSILI_FIELD_username,
                 .descend = NULL,
                 .interpretas = WANDDER_TAG_UTF8STR
         };
     dec->pop3aaainformation.members[1] =
         (struct wandder_dump_action) {
                 .name = "password",
+                .fieldid = WANDDER_ETSILI_FIELD_password,
                 .descend = NULL,
                 .interpretas = WANDDER_TAG_UTF8STR
         };
     dec->pop3aaainformation.members[2] =
         (struct wandder_dump_action) {
                 .name = "aAAResult",
+                .fieldid = WANDDER_ETSILI_FIELD_aAAResult,
                 .descend = NULL,
                 .interpretas = WANDDER_TAG_ENUM
         };
@@ -5339,30 +6367,35 @@ static void init_dumpers(wandder_etsispec_t *dec) {
     dec->asmtpaaainformation.members[0] =
         (struct wandder_dump_action) {
                 .name = "username",
+                .fieldid = WANDDER_ETSILI_FIELD_username,
                 .descend = NULL,
                 .interpretas = WANDDER_TAG_UTF8STR
         };
     dec->asmtpaaainformation.members[1] =
         (struct wandder_dump_action) {
                 .name = "authMethod",
+                .fieldid = WANDDER_ETSILI_FIELD_authMethod,
                 .descend = NULL,
                 .interpretas = WANDDER_TAG_ENUM
         };
     dec->asmtpaaainformation.members[2] =
         (struct wandder_dump_action) {
                 .name = "challenge",
+                .fieldid = WANDDER_ETSILI_FIELD_challenge,
                 .descend = NULL,
                 .interpretas = WANDDER_TAG_OCTETSTRING
         };
     dec->asmtpaaainformation.members[3] =
         (struct wandder_dump_action) {
                 .name = "response",
+                .fieldid = WANDDER_ETSILI_FIELD_response,
                 .descend = NULL,
                 .interpretas = WANDDER_TAG_OCTETSTRING
         };
     dec->asmtpaaainformation.members[4] =
         (struct wandder_dump_action) {
                 .name = "aAAResult",
+                .fieldid = WANDDER_ETSILI_FIELD_aAAResult,
                 .descend = NULL,
                 .interpretas = WANDDER_TAG_ENUM
         };
@@ -5374,12 +6407,14 @@ static void init_dumpers(wandder_etsispec_t *dec) {
     dec->iricontents.members[1] =
         (struct wandder_dump_action) {
                 .name = "emailIRI",
+                .fieldid = WANDDER_ETSILI_FIELD_emailIRI,
                 .descend = &(dec->emailiri),
                 .interpretas = WANDDER_TAG_NULL
         };
     dec->iricontents.members[2] =
         (struct wandder_dump_action) {
                 .name = "iPIRI",
+                .fieldid = WANDDER_ETSILI_FIELD_iPIRI,
                 .descend = &dec->ipiri,
                 .interpretas = WANDDER_TAG_NULL
         };
@@ -5387,6 +6422,7 @@ static void init_dumpers(wandder_etsispec_t *dec) {
     dec->iricontents.members[4] =
             (struct wandder_dump_action) {
                 .name = "uMTSIRI",
+                .fieldid = WANDDER_ETSILI_FIELD_uMTSIRI,
                 .descend = &dec->umtsiri,
                 .interpretas = WANDDER_TAG_NULL
             };
@@ -5399,6 +6435,7 @@ static void init_dumpers(wandder_etsispec_t *dec) {
     dec->iricontents.members[11] =
         (struct wandder_dump_action) {
                 .name = "iPMMIRI",
+                .fieldid = WANDDER_ETSILI_FIELD_iPMMIRI,
                 .descend = &dec->ipmmiri,
                 .interpretas = WANDDER_TAG_NULL
         };
@@ -5408,6 +6445,7 @@ static void init_dumpers(wandder_etsispec_t *dec) {
     dec->iricontents.members[15] =
         (struct wandder_dump_action) {
                 .name = "ePSIRI",
+                .fieldid = WANDDER_ETSILI_FIELD_ePSIRI,
                 .descend = &dec->epsiri,
                 .interpretas = WANDDER_TAG_NULL
         };
@@ -5423,42 +6461,49 @@ static void init_dumpers(wandder_etsispec_t *dec) {
     dec->iripayload.members[0] =
         (struct wandder_dump_action) {
                 .name = "iRIType",
+                .fieldid = WANDDER_ETSILI_FIELD_iRIType,
                 .descend = NULL,
                 .interpretas = WANDDER_TAG_ENUM
         };
     dec->iripayload.members[1] =
         (struct wandder_dump_action) {
                 .name = "timeStamp",
+                .fieldid = WANDDER_ETSILI_FIELD_timeStamp,
                 .descend = NULL,
                 .interpretas = WANDDER_TAG_GENERALTIME
         };
     dec->iripayload.members[2] =
         (struct wandder_dump_action) {
                 .name = "iRIContents",
+                .fieldid = WANDDER_ETSILI_FIELD_iRIContents,
                 .descend = &dec->iricontents,
                 .interpretas = WANDDER_TAG_NULL
         };
     dec->iripayload.members[3] =
         (struct wandder_dump_action) {
                 .name = "microSecondTimestamp",
+                .fieldid = WANDDER_ETSILI_FIELD_microSecondTimestamp,
                 .descend = &dec->msts,
                 .interpretas = WANDDER_TAG_NULL
         };
     dec->iripayload.members[4] =
         (struct wandder_dump_action) {
                 .name = "timeStampQualifier",
+                .fieldid = WANDDER_ETSILI_FIELD_timeStampQualifier,
                 .descend = NULL,
                 .interpretas = WANDDER_TAG_ENUM
         };
     dec->iripayload.members[5] =
         (struct wandder_dump_action) {
                 .name = "sessionDirection",
+                .fieldid = WANDDER_ETSILI_FIELD_sessionDirection,
                 .descend = NULL,
                 .interpretas = WANDDER_TAG_ENUM
         };
     dec->iripayload.members[6] =
         (struct wandder_dump_action) {
                 .name = "payloadDirection",
+                .fieldid = WANDDER_ETSILI_FIELD_payloadDirection,
                 .descend = NULL,
                 .interpretas = WANDDER_TAG_ENUM
         };
@@ -5469,6 +6514,7 @@ static void init_dumpers(wandder_etsispec_t *dec) {
     dec->iripayloadseq.sequence =
         (struct wandder_dump_action) {
                 .name = "IRIPayload",
+                .fieldid = WANDDER_ETSILI_FIELD_IRIPayload,
                 .descend = &dec->iripayload,
                 .interpretas = WANDDER_TAG_NULL
         };
@@ -5479,30 +6525,35 @@ static void init_dumpers(wandder_etsispec_t *dec) {
     dec->payload.members[0] =
         (struct wandder_dump_action) {
                 .name = "iRIPayloadSequence",
+                .fieldid = WANDDER_ETSILI_FIELD_iRIPayloadSequence,
                 .descend = &dec->iripayloadseq,
                 .interpretas = WANDDER_TAG_NULL
         };
     dec->payload.members[1] =
         (struct wandder_dump_action) {
                 .name = "cCPayloadSequence",
+                .fieldid = WANDDER_ETSILI_FIELD_cCPayloadSequence,
                 .descend = &dec->ccpayloadseq,
                 .interpretas = WANDDER_TAG_NULL
         };
     dec->payload.members[2] =
         (struct wandder_dump_action) {
                 .name = "tRIPayload",
+                .fieldid = WANDDER_ETSILI_FIELD_tRIPayload,
                 .descend = &(dec->tripayload),
                 .interpretas = WANDDER_TAG_NULL
         };
     dec->payload.members[3] =        // Not required
         (struct wandder_dump_action) {
                 .name = "hI1-Operation",
+                .fieldid = WANDDER_ETSILI_FIELD_hI1_Operation,
                 .descend = &(dec->hi1operation),
                 .interpretas = WANDDER_TAG_NULL
         };
     dec->payload.members[4] =
         (struct wandder_dump_action) {
                 .name = "encryptionContainer",
+                .fieldid = WANDDER_ETSILI_FIELD_encryptionContainer,
                 .descend = &(dec->encryptioncontainer),
                 .interpretas = WANDDER_TAG_NULL
         };
@@ -5519,6 +6570,7 @@ static void init_dumpers(wandder_etsispec_t *dec) {
 	dec->encryptioncontainer.members[0] = 
         (struct wandder_dump_action) {
                 .name = "encryptionType",
+                .fieldid = WANDDER_ETSILI_FIELD_encryptionType,
                 .descend = NULL,
                 .interpretas = WANDDER_TAG_ENUM
         };
@@ -5526,12 +6578,14 @@ static void init_dumpers(wandder_etsispec_t *dec) {
 	dec->encryptioncontainer.members[1] =
         (struct wandder_dump_action) {
                 .name = "encryptedPayload",
+                .fieldid = WANDDER_ETSILI_FIELD_encryptedPayload,
                 .descend = &(dec->encryptedpayload),
                 .interpretas = WANDDER_TAG_ENCRYPTED
         };
 	dec->encryptioncontainer.members[2] = 
         (struct wandder_dump_action) {
                 .name = "encryptedPayloadType",
+                .fieldid = WANDDER_ETSILI_FIELD_encryptedPayloadType,
                 .descend = NULL,
                 .interpretas = WANDDER_TAG_ENUM
         };
@@ -5541,6 +6595,7 @@ static void init_dumpers(wandder_etsispec_t *dec) {
     dec->encryptedpayloadroot.sequence =
         (struct wandder_dump_action) {
                 .name = "encryptedPayload",
+                .fieldid = WANDDER_ETSILI_FIELD_encryptedPayload,
                 .descend = &dec->encryptedpayload,
                 .interpretas = WANDDER_TAG_NULL
         };
@@ -5551,12 +6606,14 @@ static void init_dumpers(wandder_etsispec_t *dec) {
 	dec->encryptedpayload.members[0] = 
         (struct wandder_dump_action) {
                 .name = "byteCounter",
+                .fieldid = WANDDER_ETSILI_FIELD_byteCounter,
                 .descend = NULL,
                 .interpretas = WANDDER_TAG_INTEGER
         };
 	dec->encryptedpayload.members[1] = 
         (struct wandder_dump_action) {
                 .name = "payload",
+                .fieldid = WANDDER_ETSILI_FIELD_payload,
                 .descend = &(dec->payload),
                 .interpretas = WANDDER_TAG_NULL
         };
@@ -5569,54 +6626,63 @@ static void init_dumpers(wandder_etsispec_t *dec) {
     dec->psheader.members[0] =
         (struct wandder_dump_action) {
                 .name = "li-psDomainId",
+                .fieldid = WANDDER_ETSILI_FIELD_li_psDomainId,
                 .descend = NULL,
                 .interpretas = WANDDER_TAG_OID
         };
     dec->psheader.members[1] =
         (struct wandder_dump_action) {
                 .name = "lawfulInterceptionIdentifier",
+                .fieldid = WANDDER_ETSILI_FIELD_lawfulInterceptionIdentifier,
                 .descend = NULL,
                 .interpretas = WANDDER_TAG_OCTETSTRING
         };
     dec->psheader.members[2] =
         (struct wandder_dump_action) {
                 .name = "authorizationCountryCode",
+                .fieldid = WANDDER_ETSILI_FIELD_authorizationCountryCode,
                 .descend = NULL,
                 .interpretas = WANDDER_TAG_PRINTABLE
         };
     dec->psheader.members[3] =
         (struct wandder_dump_action) {
                 .name = "communicationIdentifier",
+                .fieldid = WANDDER_ETSILI_FIELD_communicationIdentifier,
                 .descend = &dec->cid,
                 .interpretas = WANDDER_TAG_NULL
         };
     dec->psheader.members[4] =
         (struct wandder_dump_action) {
                 .name = "sequenceNumber",
+                .fieldid = WANDDER_ETSILI_FIELD_sequenceNumber,
                 .descend = NULL,
                 .interpretas = WANDDER_TAG_INTEGER
         };
     dec->psheader.members[5] =
         (struct wandder_dump_action) {
                 .name = "timeStamp",
+                .fieldid = WANDDER_ETSILI_FIELD_timeStamp,
                 .descend = NULL,
                 .interpretas = WANDDER_TAG_GENERALTIME
         };
     dec->psheader.members[6] =
         (struct wandder_dump_action) {
                 .name = "interceptionPointID",
+                .fieldid = WANDDER_ETSILI_FIELD_interceptionPointID,
                 .descend = NULL,
                 .interpretas = WANDDER_TAG_PRINTABLE
         };
     dec->psheader.members[7] =
         (struct wandder_dump_action) {
                 .name = "microSecondTimeStamp",
+                .fieldid = WANDDER_ETSILI_FIELD_microSecondTimeStamp,
                 .descend = &dec->msts,
                 .interpretas = WANDDER_TAG_NULL
         };
     dec->psheader.members[8] =
         (struct wandder_dump_action) {
                 .name = "timeStampQualifier",
+                .fieldid = WANDDER_ETSILI_FIELD_timeStampQualifier,
                 .descend = NULL,
                 .interpretas = WANDDER_TAG_ENUM
         };
@@ -5629,12 +6695,14 @@ static void init_dumpers(wandder_etsispec_t *dec) {
     dec->pspdu.members[1] =
         (struct wandder_dump_action) {
                 .name = "PSHeader",
+                .fieldid = WANDDER_ETSILI_FIELD_PSHeader,
                 .descend = &dec->psheader,
                 .interpretas = WANDDER_TAG_NULL
         };
     dec->pspdu.members[2] =
         (struct wandder_dump_action) {
                 .name = "Payload",
+                .fieldid = WANDDER_ETSILI_FIELD_Payload,
                 .descend = &dec->payload,
                 .interpretas = WANDDER_TAG_NULL
         };
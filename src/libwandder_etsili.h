@@ -46,6 +46,291 @@ extern const uint8_t wandder_etsi_epsirioid[9];
 extern const uint8_t wandder_etsi_umtsirioid[9];
 extern const uint8_t wandder_etsi_epsccoid[9];
 
+/* Numeric identifiers for each of the field names used in the ETSI LI
+ * dumpers, so that fields can be identified without comparing strings.
+ * Fields that share a name also share an identifier. New identifiers must
+ * only ever be added to the end of this list.
+ */
+enum {
+    WANDDER_ETSILI_FIELD_UNKNOWN = 0,
+    WANDDER_ETSILI_FIELD_iPBinaryAddress,
+    WANDDER_ETSILI_FIELD_iPTextAddress,
+    WANDDER_ETSILI_FIELD_iP_type,
+    WANDDER_ETSILI_FIELD_iP_value,
+    WANDDER_ETSILI_FIELD_iP_assignment,
+    WANDDER_ETSILI_FIELD_iPv6PrefixLength,
+    WANDDER_ETSILI_FIELD_iPv4SubnetMask,
+    WANDDER_ETSILI_FIELD_ipAddress,
+    WANDDER_ETSILI_FIELD_countryCode,
+    WANDDER_ETSILI_FIELD_generalizedTime,
+    WANDDER_ETSILI_FIELD_winterSummerIndication,
+    WANDDER_ETSILI_FIELD_localTime,
+    WANDDER_ETSILI_FIELD_utcTime,
+    WANDDER_ETSILI_FIELD_h225CSMessageContent,
+    WANDDER_ETSILI_FIELD_h225RASMessageContent,
+    WANDDER_ETSILI_FIELD_h245MessageContent,
+    WANDDER_ETSILI_FIELD_genericMessageContent,
+    WANDDER_ETSILI_FIELD_ipSourceAddress,
+    WANDDER_ETSILI_FIELD_ipDestinationAddress,
+    WANDDER_ETSILI_FIELD_h323Content,
+    WANDDER_ETSILI_FIELD_sIPContent,
+    WANDDER_ETSILI_FIELD_originalIPMMMessage,
+    WANDDER_ETSILI_FIELD_sIPMessage,
+    WANDDER_ETSILI_FIELD_h323Message,
+    WANDDER_ETSILI_FIELD_nationalIPMMIRIParameters,
+    WANDDER_ETSILI_FIELD_iPMMIRIObjId,
+    WANDDER_ETSILI_FIELD_iPMMIRIContents,
+    WANDDER_ETSILI_FIELD_targetLocation,
+    WANDDER_ETSILI_FIELD_additionalSignalingSeq,
+    WANDDER_ETSILI_FIELD_umtsHI2Location,
+    WANDDER_ETSILI_FIELD_epsLocation,
+    WANDDER_ETSILI_FIELD_wlanLocationAttributes,
+    WANDDER_ETSILI_FIELD_eTSI671HI2Location,
+    WANDDER_ETSILI_FIELD_threeGPP33128UserLocation,
+    WANDDER_ETSILI_FIELD_userLocationInfo,
+    WANDDER_ETSILI_FIELD_gsmLocation,
+    WANDDER_ETSILI_FIELD_umtsLocation,
+    WANDDER_ETSILI_FIELD_olduserLocationInfo,
+    WANDDER_ETSILI_FIELD_lastVisitedTAI,
+    WANDDER_ETSILI_FIELD_tAIlist,
+    WANDDER_ETSILI_FIELD_threeGPP2Bsid,
+    WANDDER_ETSILI_FIELD_civicAddress,
+    WANDDER_ETSILI_FIELD_operatorSpecificInfo,
+    WANDDER_ETSILI_FIELD_uELocationTimestamp,
+    WANDDER_ETSILI_FIELD_additionalSignalling,
+    WANDDER_ETSILI_FIELD_sipHeaderLine,
+    WANDDER_ETSILI_FIELD_iPPackets,
+    WANDDER_ETSILI_FIELD_iPCCObjId,
+    WANDDER_ETSILI_FIELD_iPCCContents,
+    WANDDER_ETSILI_FIELD_uLIC_header,
+    WANDDER_ETSILI_FIELD_payload,
+    WANDDER_ETSILI_FIELD_hi3DomainId,
+    WANDDER_ETSILI_FIELD_lIID,
+    WANDDER_ETSILI_FIELD_correlation_Number,
+    WANDDER_ETSILI_FIELD_timeStamp,
+    WANDDER_ETSILI_FIELD_sequence_number,
+    WANDDER_ETSILI_FIELD_t_PDU_direction,
+    WANDDER_ETSILI_FIELD_ice_type,
+    WANDDER_ETSILI_FIELD_iPMMCCObjId,
+    WANDDER_ETSILI_FIELD_mMCCContents,
+    WANDDER_ETSILI_FIELD_frameType,
+    WANDDER_ETSILI_FIELD_streamIdentifier,
+    WANDDER_ETSILI_FIELD_mMCCprotocol,
+    WANDDER_ETSILI_FIELD_e164_Format,
+    WANDDER_ETSILI_FIELD_x25_Format,
+    WANDDER_ETSILI_FIELD_iP_Format,
+    WANDDER_ETSILI_FIELD_dNS_Format,
+    WANDDER_ETSILI_FIELD_iP_Address,
+    WANDDER_ETSILI_FIELD_pS_PDU,
+    WANDDER_ETSILI_FIELD_operatorIdentifier,
+    WANDDER_ETSILI_FIELD_networkElementIdentifier,
+    WANDDER_ETSILI_FIELD_eTSI671NEID,
+    WANDDER_ETSILI_FIELD_operator_Identifier,
+    WANDDER_ETSILI_FIELD_network_Element_Identifier,
+    WANDDER_ETSILI_FIELD_communication_Identity_Number,
+    WANDDER_ETSILI_FIELD_network_Identifier,
+    WANDDER_ETSILI_FIELD_networkIdentifier,
+    WANDDER_ETSILI_FIELD_communicationIdentityNumber,
+    WANDDER_ETSILI_FIELD_deliveryCountryCode,
+    WANDDER_ETSILI_FIELD_seconds,
+    WANDDER_ETSILI_FIELD_microSeconds,
+    WANDDER_ETSILI_FIELD_emailCC,
+    WANDDER_ETSILI_FIELD_iPCC,
+    WANDDER_ETSILI_FIELD_uMTSCC,
+    WANDDER_ETSILI_FIELD_iPMMCC,
+    WANDDER_ETSILI_FIELD_ePSCC,
+    WANDDER_ETSILI_FIELD_payloadDirection,
+    WANDDER_ETSILI_FIELD_cCContents,
+    WANDDER_ETSILI_FIELD_microSecondTimestamp,
+    WANDDER_ETSILI_FIELD_timeStampQualifier,
+    WANDDER_ETSILI_FIELD_CCPayload,
+    WANDDER_ETSILI_FIELD_messagePriority,
+    WANDDER_ETSILI_FIELD_message,
+    WANDDER_ETSILI_FIELD_includedSequenceNumbers,
+    WANDDER_ETSILI_FIELD_checkType,
+    WANDDER_ETSILI_FIELD_dataType,
+    WANDDER_ETSILI_FIELD_checkValue,
+    WANDDER_ETSILI_FIELD_hashAlgorithm,
+    WANDDER_ETSILI_FIELD_pDUAcknowledgement,
+    WANDDER_ETSILI_FIELD_Option,
+    WANDDER_ETSILI_FIELD_requestedOptions,
+    WANDDER_ETSILI_FIELD_acceptedOptions,
+    WANDDER_ETSILI_FIELD_declinedOptions,
+    WANDDER_ETSILI_FIELD_domainID,
+    WANDDER_ETSILI_FIELD_lawfulInterceptionIdentifier,
+    WANDDER_ETSILI_FIELD_communicationIdentifier,
+    WANDDER_ETSILI_FIELD_national_HI1_ASN1parameters,
+    WANDDER_ETSILI_FIELD_target_Information,
+    WANDDER_ETSILI_FIELD_liActivated,
+    WANDDER_ETSILI_FIELD_liDeactivated,
+    WANDDER_ETSILI_FIELD_liModified,
+    WANDDER_ETSILI_FIELD_alarams_indicator,
+    WANDDER_ETSILI_FIELD_integrityCheck,
+    WANDDER_ETSILI_FIELD_testPDU,
+    WANDDER_ETSILI_FIELD_paddingPDU,
+    WANDDER_ETSILI_FIELD_keep_alive,
+    WANDDER_ETSILI_FIELD_keep_aliveResponse,
+    WANDDER_ETSILI_FIELD_firstSegmentFlag,
+    WANDDER_ETSILI_FIELD_lastSegmentFlag,
+    WANDDER_ETSILI_FIELD_cINReset,
+    WANDDER_ETSILI_FIELD_operatorLeaMessage,
+    WANDDER_ETSILI_FIELD_optionRequest,
+    WANDDER_ETSILI_FIELD_optionResponse,
+    WANDDER_ETSILI_FIELD_optionComplete,
+    WANDDER_ETSILI_FIELD_pDUAcknowledgementRequest,
+    WANDDER_ETSILI_FIELD_pDUAcknowledgementResponse,
+    WANDDER_ETSILI_FIELD_printableIDType,
+    WANDDER_ETSILI_FIELD_macAddressType,
+    WANDDER_ETSILI_FIELD_ipAddressType,
+    WANDDER_ETSILI_FIELD_pDP_address_allocated_to_the_target,
+    WANDDER_ETSILI_FIELD_aPN,
+    WANDDER_ETSILI_FIELD_pDP_type,
+    WANDDER_ETSILI_FIELD_nSAPI,
+    WANDDER_ETSILI_FIELD_additionalIPaddress,
+    WANDDER_ETSILI_FIELD_gPRS_parameters,
+    WANDDER_ETSILI_FIELD_imei,
+    WANDDER_ETSILI_FIELD_imsi,
+    WANDDER_ETSILI_FIELD_msISDN,
+    WANDDER_ETSILI_FIELD_sip_uri,
+    WANDDER_ETSILI_FIELD_tel_uri,
+    WANDDER_ETSILI_FIELD_x_3GPP_Asserted_Identity,
+    WANDDER_ETSILI_FIELD_xUI,
+    WANDDER_ETSILI_FIELD_party_Qualifier,
+    WANDDER_ETSILI_FIELD_partyIdentity,
+    WANDDER_ETSILI_FIELD_services_Data_Information,
+    WANDDER_ETSILI_FIELD_e164_Number,
+    WANDDER_ETSILI_FIELD_globalCellID,
+    WANDDER_ETSILI_FIELD_rAI,
+    WANDDER_ETSILI_FIELD_sAI,
+    WANDDER_ETSILI_FIELD_oldRAI,
+    WANDDER_ETSILI_FIELD_tAI,
+    WANDDER_ETSILI_FIELD_eCGI,
+    WANDDER_ETSILI_FIELD_qosMobileRadio,
+    WANDDER_ETSILI_FIELD_qosGn,
+    WANDDER_ETSILI_FIELD_ueToNetwork,
+    WANDDER_ETSILI_FIELD_networkToUe,
+    WANDDER_ETSILI_FIELD_pDNAddressAllocation,
+    WANDDER_ETSILI_FIELD_protConfigOptions,
+    WANDDER_ETSILI_FIELD_attachType,
+    WANDDER_ETSILI_FIELD_ePSBearerIdentity,
+    WANDDER_ETSILI_FIELD_detachType,
+    WANDDER_ETSILI_FIELD_rATType,
+    WANDDER_ETSILI_FIELD_failedBearerActivationReason,
+    WANDDER_ETSILI_FIELD_ePSBearerQoS,
+    WANDDER_ETSILI_FIELD_bearerActivationType,
+    WANDDER_ETSILI_FIELD_aPN_AMBR,
+    WANDDER_ETSILI_FIELD_linkedEPSBearerId,
+    WANDDER_ETSILI_FIELD_failedBearerModificationReason,
+    WANDDER_ETSILI_FIELD_bearerDeactivationType,
+    WANDDER_ETSILI_FIELD_bearerDeactivationCause,
+    WANDDER_ETSILI_FIELD_ePSlocationOfTheTarget,
+    WANDDER_ETSILI_FIELD_pDNType,
+    WANDDER_ETSILI_FIELD_hi2epsDomainId,
+    WANDDER_ETSILI_FIELD_initiator,
+    WANDDER_ETSILI_FIELD_locationOfTheTarget,
+    WANDDER_ETSILI_FIELD_partyInformation,
+    WANDDER_ETSILI_FIELD_serviceCenterAddress,
+    WANDDER_ETSILI_FIELD_ePSCorrelationNumber,
+    WANDDER_ETSILI_FIELD_ePSevent,
+    WANDDER_ETSILI_FIELD_sgsnAddress,
+    WANDDER_ETSILI_FIELD_gPRSOperationErrorCode,
+    WANDDER_ETSILI_FIELD_ggsnAddress,
+    WANDDER_ETSILI_FIELD_qOS,
+    WANDDER_ETSILI_FIELD_sMSOriginatingAddress,
+    WANDDER_ETSILI_FIELD_sMSTerminatingAddress,
+    WANDDER_ETSILI_FIELD_iMSevent,
+    WANDDER_ETSILI_FIELD_servingSGSN_number,
+    WANDDER_ETSILI_FIELD_servingSGSN_address,
+    WANDDER_ETSILI_FIELD_ldiEvent,
+    WANDDER_ETSILI_FIELD_ePS_GTPV2_specificParameters,
+    WANDDER_ETSILI_FIELD_hi2DomainId,
+    WANDDER_ETSILI_FIELD_gPRSCorrelationNumber,
+    WANDDER_ETSILI_FIELD_gPRSevent,
+    WANDDER_ETSILI_FIELD_iRIversion,
+    WANDDER_ETSILI_FIELD_accessEventType,
+    WANDDER_ETSILI_FIELD_targetUsername,
+    WANDDER_ETSILI_FIELD_internetAccessType,
+    WANDDER_ETSILI_FIELD_iPVersion,
+    WANDDER_ETSILI_FIELD_targetIPAddress,
+    WANDDER_ETSILI_FIELD_targetNetworkID,
+    WANDDER_ETSILI_FIELD_targetCPEID,
+    WANDDER_ETSILI_FIELD_pOPPortNumber,
+    WANDDER_ETSILI_FIELD_callBackNumber,
+    WANDDER_ETSILI_FIELD_startTime,
+    WANDDER_ETSILI_FIELD_endTime,
+    WANDDER_ETSILI_FIELD_endReason,
+    WANDDER_ETSILI_FIELD_octetsReceived,
+    WANDDER_ETSILI_FIELD_octetsTransmitted,
+    WANDDER_ETSILI_FIELD_rawAAAData,
+    WANDDER_ETSILI_FIELD_expectedEndTime,
+    WANDDER_ETSILI_FIELD_pOPPhoneNumber,
+    WANDDER_ETSILI_FIELD_pOPIdentifier,
+    WANDDER_ETSILI_FIELD_pOPIPAddress,
+    WANDDER_ETSILI_FIELD_additionalIPAddress,
+    WANDDER_ETSILI_FIELD_authenticationType,
+    WANDDER_ETSILI_FIELD_iPIRIObjId,
+    WANDDER_ETSILI_FIELD_iPIRIContents,
+    WANDDER_ETSILI_FIELD_iRI_Parameters,
+    WANDDER_ETSILI_FIELD_iRI_EPS_Parameters,
+    WANDDER_ETSILI_FIELD_emailCCObjId,
+    WANDDER_ETSILI_FIELD_email_Format,
+    WANDDER_ETSILI_FIELD_email_Content,
+    WANDDER_ETSILI_FIELD_emailIRIObjId,
+    WANDDER_ETSILI_FIELD_eventType,
+    WANDDER_ETSILI_FIELD_client_Address,
+    WANDDER_ETSILI_FIELD_server_Address,
+    WANDDER_ETSILI_FIELD_client_Port,
+    WANDDER_ETSILI_FIELD_server_Port,
+    WANDDER_ETSILI_FIELD_server_Octets_Sent,
+    WANDDER_ETSILI_FIELD_client_Octets_Sent,
+    WANDDER_ETSILI_FIELD_protocol_ID,
+    WANDDER_ETSILI_FIELD_e_mail_Sender,
+    WANDDER_ETSILI_FIELD_e_mail_Recipients,
+    WANDDER_ETSILI_FIELD_status,
+    WANDDER_ETSILI_FIELD_total_Recipient_Count,
+    WANDDER_ETSILI_FIELD_message_ID,
+    WANDDER_ETSILI_FIELD_nationalParameter,
+    WANDDER_ETSILI_FIELD_national_EM_ASN1parameters,
+    WANDDER_ETSILI_FIELD_aAAInformation,
+    WANDDER_ETSILI_FIELD_e_mail_Sender_Validity,
+    WANDDER_ETSILI_FIELD_recipient,
+    WANDDER_ETSILI_FIELD_pOP3AAAInformation,
+    WANDDER_ETSILI_FIELD_aSMTPAAAInformation,
+    WANDDER_ETSILI_FIELD_iMAPAAAInformation,
+    WANDDER_ETSILI_FIELD_username,
+    WANDDER_ETSILI_FIELD_password,
+    WANDDER_ETSILI_FIELD_aAAResult,
+    WANDDER_ETSILI_FIELD_authMethod,
+    WANDDER_ETSILI_FIELD_challenge,
+    WANDDER_ETSILI_FIELD_response,
+    WANDDER_ETSILI_FIELD_emailIRI,
+    WANDDER_ETSILI_FIELD_iPIRI,
+    WANDDER_ETSILI_FIELD_uMTSIRI,
+    WANDDER_ETSILI_FIELD_iPMMIRI,
+    WANDDER_ETSILI_FIELD_ePSIRI,
+    WANDDER_ETSILI_FIELD_iRIType,
+    WANDDER_ETSILI_FIELD_iRIContents,
+    WANDDER_ETSILI_FIELD_sessionDirection,
+    WANDDER_ETSILI_FIELD_IRIPayload,
+    WANDDER_ETSILI_FIELD_iRIPayloadSequence,
+    WANDDER_ETSILI_FIELD_cCPayloadSequence,
+    WANDDER_ETSILI_FIELD_tRIPayload,
+    WANDDER_ETSILI_FIELD_hI1_Operation,
+    WANDDER_ETSILI_FIELD_encryptionContainer,
+    WANDDER_ETSILI_FIELD_encryptionType,
+    WANDDER_ETSILI_FIELD_encryptedPayload,
+    WANDDER_ETSILI_FIELD_encryptedPayloadType,
+    WANDDER_ETSILI_FIELD_byteCounter,
+    WANDDER_ETSILI_FIELD_li_psDomainId,
+    WANDDER_ETSILI_FIELD_authorizationCountryCode,
+    WANDDER_ETSILI_FIELD_sequenceNumber,
+    WANDDER_ETSILI_FIELD_interceptionPointID,
+    WANDDER_ETSILI_FIELD_microSecondTimeStamp,
+    WANDDER_ETSILI_FIELD_PSHeader,
+    WANDDER_ETSILI_FIELD_Payload,
+    WANDDER_ETSILI_FIELD_LAST
+};
+
 typedef struct wandder_etsistack {
 
     int alloced;
@@ -54,7 +339,10 @@ typedef struct wandder_etsistack {
     int *atthislevel;
 } wandder_etsi_stack_t;
 
-typedef struct wandder_etsispec {
+/* The dumpers describing the ETSI LI schema. These never change once
+ * they have been built, so a single copy is shared by all ETSI decoders.
+ */
+typedef struct wandder_etsi_dumpers {
     wandder_dumper_t ipaddress;
     wandder_dumper_t datanodeaddress;
     wandder_dumper_t timestamp;
@@ -126,6 +414,17 @@ typedef struct wandder_etsispec {
     wandder_dumper_t lipspdulocation;
     wandder_dumper_t epslocation;
 
+    /* Pre-compiled searches for locating CC and IRI contents */
+    wandder_query_t *cc_query;
+    wandder_query_t *cc_query_noencrypt;
+    wandder_query_t *cc_query_decrypted;
+    wandder_query_t *iri_query;
+    wandder_query_t *iri_query_decrypted;
+} wandder_etsi_dumpers_t;
+
+typedef struct wandder_etsispec {
+    wandder_etsi_dumpers_t *dumpers;
+
     wandder_decoder_t *dec;
     wandder_etsi_stack_t *stack;
 
@@ -141,6 +440,23 @@ typedef struct wandder_etsispec {
     uint8_t *saved_decrypted_payload;
     uint32_t saved_payload_size;
     char *saved_payload_name;
+    uint16_t saved_payload_fieldid;
+
+    /* Decryption state that is set up once and then re-used for every
+     * encrypted PDU -- the binary key, the cipher context (an
+     * EVP_CIPHER_CTX) and the buffer that plaintext is written into.
+     */
+    uint8_t decryption_key_bin[32];
+    uint8_t decryption_key_ready;
+    uint8_t decryption_env_checked;
+    void *cipherctx;
+    uint8_t *decrypt_buf;
+    uint32_t decrypt_buf_alloced;
+    wandder_tape_t *hdrtape;
+
+    /* Plaintext for the most recent batch decryption */
+    uint8_t *batch_buf;
+    uint32_t batch_buf_alloced;
 } wandder_etsispec_t;
 
 typedef enum {
@@ -337,6 +653,51 @@ typedef struct wandder_etsili_intercept_details {
     char *networkelemid;
 } wandder_etsili_intercept_details_t;
 
+/* All of the PSHeader fields, as extracted by a single pass over the
+ * header using wandder_etsili_get_header(). The string fields are views
+ * into the attached buffer (i.e. not NUL-terminated), so they are only
+ * valid for as long as that buffer is.
+ *
+ * Absent fields have a NULL pointer / zero length, and -1 for the
+ * numeric fields.
+ */
+typedef struct wandder_etsili_header {
+    uint8_t *liid;
+    uint32_t liid_len;
+    uint8_t *authcc;
+    uint32_t authcc_len;
+    uint8_t *operatorid;
+    uint32_t operatorid_len;
+    uint8_t *networkelemid;
+    uint32_t networkelemid_len;
+    uint8_t *delivcc;
+    uint32_t delivcc_len;
+    uint8_t *intpointid;
+    uint32_t intpointid_len;
+
+    int64_t cin;
+    int64_t seqno;
+    struct timeval ts;
+} wandder_etsili_header_t;
+
+/* A single encrypted payload to be decrypted as part of a batch. The
+ * ciphertext points into the original PDU, so that PDU must remain
+ * available until the batch has been decrypted. The plaintext is a view
+ * into a buffer owned by the decoder that performed the decryption and
+ * remains valid until the next batch is decrypted using that decoder.
+ */
+typedef struct wandder_etsili_decrypt_job {
+    /* Input */
+    uint8_t *ciphertext;
+    uint32_t cipherlen;
+    int64_t seqno;
+    int encrypt_method;
+
+    /* Output */
+    uint8_t *plaintext;
+    uint32_t plainlen;
+} wandder_etsili_decrypt_job_t;
+
 enum {
     WANDDER_IRI_CONTENT_IP,
     WANDDER_IRI_CONTENT_SIP,
@@ -385,6 +746,40 @@ enum {
     WANDDER_ETSILI_CC_FORMAT_RTP = 5,
 };
 
+#define WANDDER_ETSILI_VISIT_MAX_DEPTH 64
+
+/* A single field, as passed to a visitor callback by wandder_etsili_visit().
+ * The value is the raw encoded content of the field -- no conversion to
+ * text is performed.
+ */
+typedef struct wandder_etsili_field {
+    /* The dumper for the structure that contains this field */
+    wandder_dumper_t *parent;
+    /* Index into parent->members, or -1 if the field is not a member */
+    int member;
+    /* Name of the field, or NULL if the field is not recognised */
+    const char *name;
+    /* One of the WANDDER_ETSILI_FIELD_* values */
+    uint16_t fieldid;
+    uint8_t identclass;
+    uint32_t identifier;
+    /* How the field should be interpreted, i.e. one of the WANDDER_TAG_*
+     * values */
+    uint16_t interpretas;
+    uint8_t *valptr;
+    uint32_t vallen;
+    int level;
+    /* Set if the field is part of a decrypted payload */
+    uint8_t decrypted;
+} wandder_etsili_field_t;
+
+/* Visitor callbacks should return 0 to continue, 1 to skip over the
+ * contents of the current field (if it is constructed or encrypted), or
+ * -1 to stop visiting altogether.
+ */
+typedef int (*wandder_etsili_visitor_cb_t)(wandder_etsili_field_t *field,
+        void *userdata);
+
 wandder_etsispec_t *wandder_create_etsili_decoder(void);
 void wandder_free_etsili_decoder(wandder_etsispec_t *dec);
 void wandder_attach_etsili_buffer(wandder_etsispec_t *dec, uint8_t *buffer,
@@ -398,6 +793,8 @@ struct timeval wandder_etsili_get_header_timestamp(wandder_etsispec_t *dec);
 uint32_t wandder_etsili_get_pdu_length(wandder_etsispec_t *dec);
 char *wandder_etsili_get_next_fieldstr(wandder_etsispec_t *dec, char *space,
         int spacelen);
+int wandder_etsili_visit(wandder_etsispec_t *dec,
+        wandder_etsili_visitor_cb_t cb, void *userdata);
 uint8_t *wandder_etsili_get_cc_contents(wandder_etsispec_t *dec, uint32_t *len,
         char *name, int namelen);
 uint8_t *wandder_etsili_get_iri_contents(wandder_etsispec_t *dec,
@@ -410,9 +807,15 @@ uint32_t wandder_etsili_get_cin(wandder_etsispec_t *dec);
 int wandder_etsili_is_keepalive(wandder_etsispec_t *etsidec);
 int wandder_etsili_is_keepalive_response(wandder_etsispec_t *etsidec);
 int64_t wandder_etsili_get_sequence_number(wandder_etsispec_t *etsidec);
+int wandder_etsili_get_header(wandder_etsispec_t *etsidec,
+        wandder_etsili_header_t *hdr);
 uint8_t wandder_etsili_get_cc_format(wandder_etsispec_t *etsidec);
 uint8_t *wandder_etsili_get_encryption_container(
         wandder_etsispec_t *etsidec, wandder_decoder_t *dec, uint32_t *len);
+int wandder_etsili_prepare_decrypt_job(wandder_etsispec_t *etsidec,
+        wandder_etsili_decrypt_job_t *job);
+int wandder_etsili_decrypt_batch(wandder_etsispec_t *etsidec,
+        wandder_etsili_decrypt_job_t *jobs, int count);
 
 #endif
 // vim: set sw=4 tabstop=4 softtabstop=4 expandtab :
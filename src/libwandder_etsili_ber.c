@@ -111,49 +111,110 @@ static inline void encode_ipaddress(wandder_encoder_ber_t* enc_ber,
     free(addr->ipvalue);
 }
 
-//ensures that the buffer exceeds child->body.buf + currlen in allocated memeroy
-//adjusts all internal pointers accordingly if realloc
-//returns the difference between new, and old buffers
-static ptrdiff_t check_body_size(wandder_etsili_child_t * child, size_t currlen){
-    
+/* Upper bound on the encoded size of a single field, including its
+ * identifier and length octets.
+ */
+static inline size_t field_worst_case(uint8_t idnum, uint8_t encodeas,
+        size_t vallen) {
+
+    if (encodeas == WANDDER_TAG_GENERALTIME ||
+            encodeas == WANDDER_TAG_UTCTIME) {
+        /* vallen is the size of the timeval, not the encoded string */
+        return calculate_length(idnum, WANDDER_CLASS_CONTEXT_PRIMITIVE,
+                WANDDER_TAG_OCTETSTRING, MAX_ENCODED_TIME_LEN);
+    }
+    return calculate_length(idnum, WANDDER_CLASS_CONTEXT_PRIMITIVE,
+            encodeas, vallen);
+}
+
+/* Upper bound on the output of encode_ipaddress_inplace() */
+static size_t ipaddress_worst_case(wandder_etsili_ipaddress_t *addr) {
+
+    size_t len;
+
+    len = field_worst_case(1, WANDDER_TAG_ENUM, sizeof(uint32_t));
+    len += field_worst_case(2, WANDDER_TAG_SEQUENCE, 0) + 2;
+    if (addr->valtype == WANDDER_IPADDRESS_REP_BINARY) {
+        len += field_worst_case(1, WANDDER_TAG_OCTETSTRING, 16);
+    } else {
+        len += field_worst_case(2, WANDDER_TAG_IA5,
+                strlen((char *)addr->ipvalue));
+    }
+    len += field_worst_case(3, WANDDER_TAG_ENUM, sizeof(uint32_t));
+
+    if (addr->v6prefixlen > 0) {
+        len += field_worst_case(4, WANDDER_TAG_INTEGER, sizeof(uint32_t));
+    }
+    if (addr->v4subnetmask > 0) {
+        len += field_worst_case(5, WANDDER_TAG_OCTETSTRING,
+                sizeof(addr->v4subnetmask));
+    }
+    return len;
+}
+
+//ensures that the child buffer can hold a body of bodylen bytes after the
+//header. Callers pass the worst case for the whole record so that every
+//field can be written without further checks, and the buffer can never
+//move part way through a record.
+static void reserve_body_space(wandder_etsili_child_t * child,
+        size_t bodylen){
+
     uint8_t* new;
-    ptrdiff_t offset = 0;
-
-    if (currlen + (child->body.data - child->buf) > child->alloc_len){
-        child->alloc_len = child->len + currlen + child->owner->increment_len;
-        child->body.alloc_len = child->alloc_len - child->header.len;
-        new = realloc(child->buf, child->alloc_len);
-        if (new == NULL){
-            //TODO handle realloc fail
-            fprintf(stderr, "unable to alloc mem\n");
-            assert(0);
-        }
-        
-        //update all refrences
-        if (new != child->body.buf){ //only need to update if alloc moved
-            ptrdiff_t offset = (new - child->buf);
-            child->buf          += offset;
-            child->header.buf   += offset;
-            child->header.cin   += offset;
-            child->header.seqno += offset;
-            child->header.sec   += offset;
-            child->header.usec  += offset;
-            child->header.end   += offset;
-
-            child->body.buf     += offset;
-            child->body.meta    += offset; 
-            child->body.data    += offset;
-            return offset;
-        }
+    etsili_pshdr_diff_t hdrdiff;
+    ptrdiff_t metadiff, datadiff;
+
+    if (child->header.len + bodylen <= child->alloc_len){
+        return;
+    }
+
+    //remember where everything is, as the buffer may move
+    hdrdiff.cin_diff    = child->header.cin - child->buf;
+    hdrdiff.seqno_diff  = child->header.seqno - child->buf;
+    hdrdiff.sec_diff    = child->header.sec - child->buf;
+    hdrdiff.usec_diff   = child->header.usec - child->buf;
+    hdrdiff.end_diff    = child->header.end - child->buf;
+    metadiff            = child->body.meta - child->buf;
+    datadiff            = child->body.data - child->buf;
+
+    child->alloc_len = child->header.len + bodylen +
+            child->owner->increment_len;
+    child->body.alloc_len = child->alloc_len - child->header.len;
+    new = realloc(child->buf, child->alloc_len);
+    if (new == NULL){
+        //TODO handle realloc fail
+        fprintf(stderr, "unable to alloc mem\n");
+        assert(0);
     }
-    return offset;
+
+    //update all refrences
+    child->buf          = new;
+    child->header.buf   = new;
+    child->header.cin   = new + hdrdiff.cin_diff;
+    child->header.seqno = new + hdrdiff.seqno_diff;
+    child->header.sec   = new + hdrdiff.sec_diff;
+    child->header.usec  = new + hdrdiff.usec_diff;
+    child->header.end   = new + hdrdiff.end_diff;
+
+    child->body.buf     = new + child->header.len;
+    child->body.meta    = new + metadiff;
+    child->body.data    = new + datadiff;
+}
+
+/* Reserves room for a body consisting of the existing fields up to
+ * body.data, an IP packet and 'trailer' bytes after the packet.
+ */
+static inline void reserve_ippacket_body(wandder_etsili_child_t * child,
+        uint8_t idnum, size_t iplen, size_t trailer) {
+
+    reserve_body_space(child, (child->body.data - child->body.buf) +
+            calculate_length(idnum, WANDDER_CLASS_CONTEXT_PRIMITIVE,
+                    WANDDER_TAG_IPPACKET, iplen) + trailer);
 }
 
 inline static void preencoded_here(uint8_t** ptr, ptrdiff_t * rem, int index, 
         wandder_etsili_child_t * child) {
 
     size_t ret = child->owner->preencoded[index]->len;
-    *ptr += check_body_size(child, (*ptr - child->body.buf) + ret);
     memcpy(*ptr, 
             child->owner->preencoded[index]->buf, ret);
     *ptr += ret;
@@ -166,7 +227,6 @@ inline static void encode_here_ber_update(
         uint8_t** ptr, ptrdiff_t* rem,
         wandder_etsili_child_t * child){
 
-    *ptr += check_body_size(child, (*ptr - child->body.buf) + 512);
     size_t ret = encode_here_ber(
                 idnum,
                 class,
@@ -242,30 +302,72 @@ static inline void encode_ipaddress_inplace(
     free(addr->ipvalue);
 }
 
-static void free_generic_body(wandder_generic_body_t * body) {
+/* Drops a reference to a definite length template, freeing it if nothing
+ * else refers to it any more.
+ */
+static inline void release_definite_template(
+        wandder_definite_template_t *tmpl) {
+
+    if (tmpl && __atomic_sub_fetch(&(tmpl->refs), 1, __ATOMIC_ACQ_REL) == 0) {
+        free(tmpl->buf);
+        free(tmpl);
+    }
+}
+
+static inline void free_child_memory(wandder_etsili_child_t *child) {
+    if (child->buf)
+        free(child->buf);
+    release_definite_template(child->definite);
+    free(child);
+}
+
+/* Drops a reference to a child freelist, freeing it if nothing else
+ * refers to it any more.
+ */
+static inline void release_child_freelist(
+        wandder_etsili_child_freelist_t *flist) {
+
+    if (__atomic_sub_fetch(&(flist->counter), 1, __ATOMIC_ACQ_REL) == 0) {
+        free(flist);
+    }
+}
+
+/* Removes every child from a freelist that is being deleted and frees
+ * them.
+ */
+static void drain_child_freelist(wandder_etsili_child_freelist_t *flist) {
 
     wandder_etsili_child_t * head = NULL;
     wandder_etsili_child_t * next = NULL;
 
+    head = __atomic_exchange_n(&(flist->first), NULL, __ATOMIC_ACQ_REL);
+    while (head){
+        next = head->nextfree;
+        free_child_memory(head);
+        __atomic_sub_fetch(&(flist->freecount), 1, __ATOMIC_RELAXED);
+        release_child_freelist(flist);
+        head = next;
+    }
+}
+
+static void free_generic_body(wandder_generic_body_t * body) {
+
+    wandder_etsili_child_freelist_t *flist = body->flist;
+
     if (body->buf){
         free(body->buf);
     }
 
-    if (body->flist) {
-        //obtain lock and remove list from flist to prevent lock contention
-        // (could make the mutex recursive instead?)
-        if (pthread_mutex_lock(&(body->flist->mutex)) == 0){
-            head = body->flist->first;
-            body->flist->first = NULL;
-            body->flist->marked_for_delete = 1;
-            pthread_mutex_unlock(&(body->flist->mutex));
-        }
-        while (head){
-            next = head->nextfree;
-            wandder_free_child(head);
-            head = next;
-        }
-        free(body->flist);
+    release_definite_template(body->definite);
+    body->definite = NULL;
+
+    if (flist) {
+        /* Any children that are still in use will free themselves,
+         * rather than returning to the freelist, once they see this */
+        __atomic_store_n(&(flist->marked_for_delete), 1, __ATOMIC_SEQ_CST);
+        drain_child_freelist(flist);
+        release_child_freelist(flist);
+        body->flist = NULL;
     }
 } 
 static void clear_preencoded_fields_ber( wandder_buf_t **pendarray ) {
@@ -550,12 +652,7 @@ static uint8_t* wandder_encode_body_data_ber(
         uint8_t * valptr,
         size_t vallen){
 
-    ptrdiff_t currlen = calculate_length(idnum, class, encodeas, vallen); 
-    
-    //if new length cannot fit in old space make more
-    // if currlen+(currptr-baseptr) > alloclen
-    check_body_size(child, currlen);
-
+    //space must already have been reserved by the caller
     ptrdiff_t rem = child->alloc_len - (child->body.data - child->buf);
 
     size_t ret = encode_here_ber(idnum, class, encodeas, valptr, vallen, 
@@ -675,29 +772,96 @@ static void init_etsili_pshdr_pc(wandder_encoder_ber_t* enc_ber,
     free(res_ber);
 }
 
-static void update_etsili_ipcc(
-        void* ipcontents, size_t iplen, uint8_t dir, 
-        wandder_etsili_child_t * child) {
+#define DEFINITE_MAX_RECORD_LEN \
+        ((1UL << (8 * WANDDER_ETSILI_DEFINITE_LENOCTS)) - 1)
+
+//writes the length slots of a definite length record that is recordlen
+//bytes long in total
+static void patch_definite_lengths(wandder_definite_template_t *tmpl,
+        uint8_t *record, size_t recordlen) {
+
+    uint8_t i, j;
+    size_t len;
+    uint8_t *slot;
+
+    for (i = 0; i < tmpl->slotcount; i++) {
+        slot = record + tmpl->slots[i];
+        len = recordlen - (tmpl->slots[i] + 1 +
+                WANDDER_ETSILI_DEFINITE_LENOCTS);
+
+        slot[0] = 0x80 | WANDDER_ETSILI_DEFINITE_LENOCTS;
+        for (j = WANDDER_ETSILI_DEFINITE_LENOCTS; j > 0; j--) {
+            slot[j] = len & 0xff;
+            len >>= 8;
+        }
+    }
+}
+
+//checks that a record carrying iplen bytes of data will fit in the length
+//slots, if the child is using definite lengths
+static inline int cc_record_fits(wandder_definite_template_t *tmpl,
+        size_t iplen) {
+
+    /* 64 covers the data preamble and anything that follows the data */
+    if (tmpl && tmpl->len + iplen + 64 > DEFINITE_MAX_RECORD_LEN) {
+        fprintf(stderr,
+                "wandder: %zu bytes is too large for a definite length record\n",
+                iplen);
+        return 0;
+    }
+    return 1;
+}
+
+//finishes a CC record that ends at ptr, plus 'extra' bytes that are not
+//held in the buffer. Indefinite length records get their end-of-contents
+//octets, definite length ones have their length slots filled in instead.
+//Returns the new end of the record.
+static inline uint8_t *close_cc_record(wandder_etsili_child_t * child,
+        uint8_t *ptr, size_t extra, uint8_t endseqs) {
+
+    if (child->definite == NULL) {
+        ENDCONSTRUCTEDBLOCK(ptr, endseqs)
+        return ptr;
+    }
+
+    patch_definite_lengths(child->definite, child->buf,
+            (ptr - child->buf) + extra);
+    return ptr;
+}
+
+//rewrites the direction field that sits at the meta position of every
+//CC body
+static inline void update_cc_direction(uint8_t dir, uint8_t *meta,
+        wandder_etsili_top_t * top) {
+
     if (dir == 0) {
-        memcpy(child->body.meta, 
-                child->owner->preencoded[WANDDER_PREENCODE_DIRFROM]->buf, 
-                child->owner->preencoded[WANDDER_PREENCODE_DIRFROM]->len);
+        memcpy(meta, 
+                top->preencoded[WANDDER_PREENCODE_DIRFROM]->buf, 
+                top->preencoded[WANDDER_PREENCODE_DIRFROM]->len);
     } else if (dir == 1) {
-        memcpy(child->body.meta, 
-                child->owner->preencoded[WANDDER_PREENCODE_DIRTO]->buf, 
-                child->owner->preencoded[WANDDER_PREENCODE_DIRTO]->len);
+        memcpy(meta, 
+                top->preencoded[WANDDER_PREENCODE_DIRTO]->buf, 
+                top->preencoded[WANDDER_PREENCODE_DIRTO]->len);
     } else if (dir == 2) {
-        memcpy(child->body.meta, 
-                child->owner->preencoded[WANDDER_PREENCODE_DIRUNKNOWN]->buf, 
-                child->owner->preencoded[WANDDER_PREENCODE_DIRUNKNOWN]->len);
+        memcpy(meta, 
+                top->preencoded[WANDDER_PREENCODE_DIRUNKNOWN]->buf, 
+                top->preencoded[WANDDER_PREENCODE_DIRUNKNOWN]->len);
     } else {
         ber_rebuild_integer(
             WANDDER_CLASS_CONTEXT_PRIMITIVE, 
             0, 
             &(dir), 
             sizeof dir,
-            child->body.meta);
+            meta);
     }
+}
+
+static void update_etsili_ipcc(
+        void* ipcontents, size_t iplen, uint8_t dir, 
+        wandder_etsili_child_t * child) {
+    update_cc_direction(dir, child->body.meta, child->owner);
+
+    reserve_ippacket_body(child, 0, iplen, 7*2);
 
     uint8_t* ptr = wandder_encode_body_data_ber(
             child,
@@ -707,8 +871,7 @@ static void update_etsili_ipcc(
             ipcontents, 
             iplen);
 
-    ptr += check_body_size(child, (ptr - child->body.buf) + (7*2));
-    ENDCONSTRUCTEDBLOCK(ptr,7)
+    ptr = close_cc_record(child, ptr, 0, 7);
     child->body.len = ptr - child->body.buf;
     child->len = ptr - child->buf;
 
@@ -721,26 +884,12 @@ static void update_etsili_ipmmcc(
     uint32_t frametype = 0; //TODO these are hard coded to 0? 
     uint32_t mmccproto = 0; //at least they are in etsili_core.c in OpenLI
 
-    if (dir == 0) {
-        memcpy(child->body.meta, 
-                child->owner->preencoded[WANDDER_PREENCODE_DIRFROM]->buf, 
-                child->owner->preencoded[WANDDER_PREENCODE_DIRFROM]->len);
-    } else if (dir == 1) {
-        memcpy(child->body.meta, 
-                child->owner->preencoded[WANDDER_PREENCODE_DIRTO]->buf, 
-                child->owner->preencoded[WANDDER_PREENCODE_DIRTO]->len);
-    } else if (dir == 2) {
-        memcpy(child->body.meta, 
-                child->owner->preencoded[WANDDER_PREENCODE_DIRUNKNOWN]->buf, 
-                child->owner->preencoded[WANDDER_PREENCODE_DIRUNKNOWN]->len);
-    } else {
-        ber_rebuild_integer(
-            WANDDER_CLASS_CONTEXT_PRIMITIVE, 
-            0, 
-            &(dir), 
-            sizeof dir,
-            child->body.meta);
-    }
+    update_cc_direction(dir, child->body.meta, child->owner);
+
+    reserve_ippacket_body(child, 1, iplen,
+            field_worst_case(2, WANDDER_TAG_INTEGER, sizeof frametype) +
+            field_worst_case(4, WANDDER_TAG_INTEGER, sizeof mmccproto) +
+            (6*2));
 
     uint8_t* ptr = wandder_encode_body_data_ber(
             child,
@@ -750,10 +899,6 @@ static void update_etsili_ipmmcc(
             ipcontents, 
             iplen);
 
-    //ensure there is enough space for the last section
-    ptr += check_body_size(child, (ptr - child->body.buf) +
-            (6*2) + (child->owner->preencoded[WANDDER_PREENCODE_DIRUNKNOWN]->len *2));
-
     ptr += ber_rebuild_integer(
             WANDDER_CLASS_CONTEXT_PRIMITIVE, 
             2, 
@@ -768,7 +913,7 @@ static void update_etsili_ipmmcc(
             sizeof mmccproto,
             ptr);
     
-    ENDCONSTRUCTEDBLOCK(ptr,6) //endseq
+    ptr = close_cc_record(child, ptr, 0, 6); //endseq
     child->body.len = ptr - child->body.buf;
     child->len = ptr - child->buf;
 }
@@ -784,6 +929,8 @@ static void update_etsili_ipmmiri(
             sizeof iritype,
             child->body.meta);
 
+    reserve_ippacket_body(child, 2, iplen, 8*2);
+
     uint8_t* ptr = wandder_encode_body_data_ber(
             child,
             WANDDER_CLASS_CONTEXT_PRIMITIVE, 
@@ -792,13 +939,83 @@ static void update_etsili_ipmmiri(
             ipcontents, 
             iplen);
 
-    //ensure there is enough space for the last section
-    ptr += check_body_size(child, (ptr - child->body.buf) + (8*2));
-    ENDCONSTRUCTEDBLOCK(ptr,8)
+    ptr = close_cc_record(child, ptr, 0, 8);
     child->body.len = ptr - child->body.buf;
     child->len = ptr - child->buf;
 }
 
+/* Upper bound on the encoded size of the IP IRI parameters, mirroring
+ * each of the cases in update_etsili_ipiri().
+ */
+static size_t ipiri_worst_case(wandder_etsili_generic_t *params) {
+
+    wandder_etsili_generic_t *p, *tmp;
+    wandder_ipiri_id_t* iriid;
+    size_t len = 0;
+
+    HASH_ITER(hh, params, p, tmp) {
+        switch(p->itemnum) {
+            case WANDDER_IPIRI_CONTENTS_ACCESS_EVENT_TYPE:
+            case WANDDER_IPIRI_CONTENTS_INTERNET_ACCESS_TYPE:
+            case WANDDER_IPIRI_CONTENTS_IPVERSION:
+            case WANDDER_IPIRI_CONTENTS_ENDREASON:
+            case WANDDER_IPIRI_CONTENTS_AUTHENTICATION_TYPE:
+                len += field_worst_case(p->itemnum, WANDDER_TAG_ENUM,
+                        p->itemlen);
+                break;
+
+            case WANDDER_IPIRI_CONTENTS_TARGET_USERNAME:
+            case WANDDER_IPIRI_CONTENTS_RAW_AAA_DATA:
+            case WANDDER_IPIRI_CONTENTS_TARGET_NETWORKID:
+            case WANDDER_IPIRI_CONTENTS_TARGET_CPEID:
+            case WANDDER_IPIRI_CONTENTS_TARGET_LOCATION:
+            case WANDDER_IPIRI_CONTENTS_CALLBACK_NUMBER:
+            case WANDDER_IPIRI_CONTENTS_POP_PHONENUMBER:
+                len += field_worst_case(p->itemnum,
+                        WANDDER_TAG_OCTETSTRING, p->itemlen);
+                break;
+
+            case WANDDER_IPIRI_CONTENTS_TARGET_IPADDRESS:
+            case WANDDER_IPIRI_CONTENTS_POP_IPADDRESS:
+            case WANDDER_IPIRI_CONTENTS_ADDITIONAL_IPADDRESS:
+                len += field_worst_case(p->itemnum, WANDDER_TAG_SEQUENCE, 0);
+                len += ipaddress_worst_case(
+                        (wandder_etsili_ipaddress_t *)(p->itemptr));
+                len += 2;
+                break;
+
+            case WANDDER_IPIRI_CONTENTS_POP_IDENTIFIER:
+                iriid = (wandder_ipiri_id_t *)p->itemptr;
+                len += field_worst_case(p->itemnum, WANDDER_TAG_SEQUENCE, 0);
+                if (iriid->type == WANDDER_IPIRI_ID_PRINTABLE) {
+                    len += field_worst_case(0, WANDDER_TAG_UTF8STR,
+                            strlen(iriid->content.printable));
+                } else if (iriid->type == WANDDER_IPIRI_ID_MAC) {
+                    len += field_worst_case(1, WANDDER_TAG_OCTETSTRING, 6);
+                } else if (iriid->type == WANDDER_IPIRI_ID_IPADDR) {
+                    len += field_worst_case(2, WANDDER_TAG_SEQUENCE, 0) + 2;
+                }
+                len += 2;
+                break;
+
+            case WANDDER_IPIRI_CONTENTS_POP_PORTNUMBER:
+            case WANDDER_IPIRI_CONTENTS_OCTETS_RECEIVED:
+            case WANDDER_IPIRI_CONTENTS_OCTETS_TRANSMITTED:
+                len += field_worst_case(p->itemnum, WANDDER_TAG_INTEGER,
+                        p->itemlen);
+                break;
+
+            case WANDDER_IPIRI_CONTENTS_STARTTIME:
+            case WANDDER_IPIRI_CONTENTS_ENDTIME:
+            case WANDDER_IPIRI_CONTENTS_EXPECTED_ENDTIME:
+                len += field_worst_case(p->itemnum, WANDDER_TAG_GENERALTIME,
+                        p->itemlen);
+                break;
+        }
+    }
+    return len;
+}
+
 static void update_etsili_ipiri(
         wandder_etsili_generic_t *params, wandder_etsili_iri_type_t iritype, 
         wandder_etsili_child_t * child) {
@@ -806,10 +1023,13 @@ static void update_etsili_ipiri(
     wandder_etsili_generic_t *p, *tmp;
     wandder_ipiri_id_t* iriid;
     size_t ret;
-    uint8_t * ptr = child->body.data;
-    ptrdiff_t data_ptr_diff = ptr - child->buf;
-    ptrdiff_t rem = child->alloc_len - (ptr - child->buf);
-    
+    uint8_t * ptr;
+    ptrdiff_t rem;
+
+    reserve_body_space(child, (child->body.data - child->body.buf) +
+            ipiri_worst_case(params) + (7*2));
+    ptr = child->body.data;
+
     ber_rebuild_integer(
             WANDDER_CLASS_CONTEXT_PRIMITIVE, 
             0, 
@@ -820,9 +1040,7 @@ static void update_etsili_ipiri(
     //do params here from
     HASH_SRT(hh, params, sort_etsili_generic);
     HASH_ITER(hh, params, p, tmp) {
-        ptr += check_body_size(child, (ptr - child->body.buf) + 512);
         rem = child->alloc_len - (ptr - child->buf);
-        //need a better way then just making it bigger before hand (maybe?)
         switch(p->itemnum) {
             case WANDDER_IPIRI_CONTENTS_ACCESS_EVENT_TYPE:
             case WANDDER_IPIRI_CONTENTS_INTERNET_ACCESS_TYPE:
@@ -973,9 +1191,6 @@ static void update_etsili_ipiri(
         }
     }
 
-    //ensure there is enough space for the last section
-    child->body.data = data_ptr_diff + child->buf;
-    ptr += check_body_size(child, (ptr - child->body.buf) + (8*2));
     ENDCONSTRUCTEDBLOCK(ptr,7) //endseq
     child->body.len = ptr - child->body.buf;
     child->len = ptr - child->buf;
@@ -985,26 +1200,9 @@ static void update_etsili_ipiri(
 static void update_etsili_umtscc(
         void* ipcontents, size_t iplen, uint8_t dir, 
         wandder_etsili_child_t * child) {
-    if (dir == 0) {
-        memcpy(child->body.meta, 
-                child->owner->preencoded[WANDDER_PREENCODE_DIRFROM]->buf, 
-                child->owner->preencoded[WANDDER_PREENCODE_DIRFROM]->len);
-    } else if (dir == 1) {
-        memcpy(child->body.meta, 
-                child->owner->preencoded[WANDDER_PREENCODE_DIRTO]->buf, 
-                child->owner->preencoded[WANDDER_PREENCODE_DIRTO]->len);
-    } else if (dir == 2) {
-        memcpy(child->body.meta, 
-                child->owner->preencoded[WANDDER_PREENCODE_DIRUNKNOWN]->buf, 
-                child->owner->preencoded[WANDDER_PREENCODE_DIRUNKNOWN]->len);
-    } else {
-        ber_rebuild_integer(
-            WANDDER_CLASS_CONTEXT_PRIMITIVE, 
-            0, 
-            &(dir), 
-            sizeof dir,
-            child->body.meta);
-    }
+    update_cc_direction(dir, child->body.meta, child->owner);
+
+    reserve_ippacket_body(child, 4, iplen, 5*2);
 
     uint8_t* ptr = wandder_encode_body_data_ber(
             child,
@@ -1014,11 +1212,143 @@ static void update_etsili_umtscc(
             ipcontents, 
             iplen);
 
-    ptr += check_body_size(child, (ptr - child->body.buf) + (5*2));
-    ENDCONSTRUCTEDBLOCK(ptr,5)
+    ptr = close_cc_record(child, ptr, 0, 5);
+    child->body.len = ptr - child->body.buf;
+    child->len = ptr - child->buf;
+
+}
+
+/* Encodes a CC body up to and including the identifier and length of the
+ * IP packet, followed by the end-of-contents octets for 'endseqs' open
+ * sequences, without copying the packet itself. The resulting record is
+ * described by the three iovecs: the buffered preamble, the caller's
+ * packet and the buffered trailer.
+ */
+static int update_etsili_cc_iov(
+        void* ipcontents, size_t iplen, uint8_t idnum, uint8_t endseqs,
+        wandder_etsili_child_t * child, struct iovec *iov) {
+
+    uint8_t *ptr;
+    size_t preamble;
+
+    //the packet itself is not stored, only its identifier and length
+    reserve_body_space(child, (child->body.data - child->body.buf) +
+            calculate_length(idnum, WANDDER_CLASS_CONTEXT_PRIMITIVE,
+                    WANDDER_TAG_IPPACKET, iplen) - iplen + (endseqs * 2));
+
+    ptr = child->body.data;
+    preamble = encode_preamble_here_ber(idnum,
+            WANDDER_CLASS_CONTEXT_PRIMITIVE, iplen, ptr,
+            child->alloc_len - (ptr - child->buf));
+    if (preamble == 0) {
+        return -1;
+    }
+    ptr += preamble;
+
+    iov[0].iov_base = child->buf;
+    iov[0].iov_len = ptr - child->buf;
+    iov[1].iov_base = ipcontents;
+    iov[1].iov_len = iplen;
+    iov[2].iov_base = ptr;
+
+    ptr = close_cc_record(child, ptr, iplen, endseqs);
+    iov[2].iov_len = ptr - (uint8_t *)iov[2].iov_base;
+
+    /* NOTE: the buffer holds everything except the packet, so buf/len no
+     * longer describe a complete record */
     child->body.len = ptr - child->body.buf;
     child->len = ptr - child->buf;
+    return WANDDER_ETSILI_CC_IOV_COUNT;
+}
+
+/* Preencoded fields that are present in every UMTS IRI record */
+static const int umtsiri_fixed_preencoded[] = {
+    WANDDER_PREENCODE_CSEQUENCE_2,
+    WANDDER_PREENCODE_CSEQUENCE_4,
+    WANDDER_PREENCODE_CSEQUENCE_0,
+    WANDDER_PREENCODE_UMTSIRIOID,
+    WANDDER_PREENCODE_LIID,
+    WANDDER_PREENCODE_CSEQUENCE_3,
+    WANDDER_PREENCODE_CSEQUENCE_8,
+    WANDDER_PREENCODE_CSEQUENCE_13,
+    WANDDER_PREENCODE_CSEQUENCE_0,
+    WANDDER_PREENCODE_CSEQUENCE_9,
+    WANDDER_PREENCODE_CSEQUENCE_1,
+    WANDDER_PREENCODE_CSEQUENCE_4,
+    WANDDER_PREENCODE_CSEQUENCE_1,
+    WANDDER_PREENCODE_CSEQUENCE_26,
+};
+
+/* Upper bound on the encoded size of a UMTS IRI body from the meta field
+ * onwards, mirroring update_etsili_umtsiri().
+ */
+static size_t umtsiri_worst_case(wandder_etsili_generic_t *params,
+        wandder_etsili_top_t *top) {
+
+    wandder_etsili_generic_t *p, *tmp;
+    wandder_buf_t **pre = top->preencoded;
+    size_t len = 0;
+    size_t i;
+
+    /* iri type, gprs target, iri version and every end of sequence */
+    len += field_worst_case(0, WANDDER_TAG_ENUM, sizeof(uint32_t)) * 3;
+    len += (1 + 3 + 1 + 3 + 8) * 2;
+
+    for (i = 0; i < sizeof(umtsiri_fixed_preencoded) /
+            sizeof(umtsiri_fixed_preencoded[0]); i++) {
+        len += pre[umtsiri_fixed_preencoded[i]]->len;
+    }
 
+    /* All of the UMTS IRI identifiers fit in a single octet, so the
+     * identifier number itself makes no difference to the size */
+    HASH_ITER(hh, params, p, tmp) {
+        switch(p->itemnum) {
+            case WANDDER_UMTSIRI_CONTENTS_EVENT_TIME:
+                len += field_worst_case(1, WANDDER_TAG_GENERALTIME,
+                        p->itemlen);
+                len += field_worst_case(1, WANDDER_TAG_UTCTIME, p->itemlen);
+                break;
+            case WANDDER_UMTSIRI_CONTENTS_LOCATION_TIME:
+                len += field_worst_case(0, WANDDER_TAG_UTCTIME, p->itemlen);
+                break;
+            case WANDDER_UMTSIRI_CONTENTS_INITIATOR:
+            case WANDDER_UMTSIRI_CONTENTS_EVENT_TYPE:
+                len += field_worst_case(0, WANDDER_TAG_ENUM, p->itemlen);
+                break;
+            case WANDDER_UMTSIRI_CONTENTS_CGI:
+            case WANDDER_UMTSIRI_CONTENTS_SAI:
+            case WANDDER_UMTSIRI_CONTENTS_TAI:
+            case WANDDER_UMTSIRI_CONTENTS_ECGI:
+            case WANDDER_UMTSIRI_CONTENTS_IMEI:
+            case WANDDER_UMTSIRI_CONTENTS_IMSI:
+            case WANDDER_UMTSIRI_CONTENTS_MSISDN:
+            case WANDDER_UMTSIRI_CONTENTS_APNAME:
+            case WANDDER_UMTSIRI_CONTENTS_PDPTYPE:
+            case WANDDER_UMTSIRI_CONTENTS_GPRS_ERROR_CODE:
+            case WANDDER_UMTSIRI_CONTENTS_OPERATOR_IDENTIFIER:
+                len += field_worst_case(0, WANDDER_TAG_OCTETSTRING,
+                        p->itemlen);
+                break;
+            case WANDDER_UMTSIRI_CONTENTS_GPRS_CORRELATION:
+                /* printed as a decimal string of at most 23 characters */
+                len += field_worst_case(0, WANDDER_TAG_OCTETSTRING, 23);
+                break;
+            case WANDDER_UMTSIRI_CONTENTS_PDP_ADDRESS:
+                len += pre[WANDDER_PREENCODE_CSEQUENCE_1]->len * 2;
+                len += ipaddress_worst_case(
+                        (wandder_etsili_ipaddress_t *)(p->itemptr));
+                len += 2 * 2;
+                break;
+            case WANDDER_UMTSIRI_CONTENTS_GGSN_IPADDRESS:
+                len += pre[WANDDER_PREENCODE_CSEQUENCE_1]->len;
+                len += pre[WANDDER_PREENCODE_CSEQUENCE_5]->len;
+                len += ipaddress_worst_case(
+                        (wandder_etsili_ipaddress_t *)(p->itemptr));
+                len += 2 * 2;
+                break;
+        }
+    }
+    return len;
 }
 
 static void update_etsili_umtsiri(
@@ -1030,11 +1360,13 @@ static void update_etsili_umtsiri(
     uint8_t lookup;
     uint32_t iriversion = 8;
     uint32_t gprstarget = 3;
-    uint8_t * ptr = child->body.meta; //start from meta,
-    ptrdiff_t data_ptr_diff = ptr - child->buf;
+    uint8_t * ptr;
     ptrdiff_t rem;
-    
-    ptr += check_body_size(child, (ptr - child->body.buf) + 512);
+
+    reserve_body_space(child, (child->body.meta - child->body.buf) +
+            umtsiri_worst_case(params, child->owner));
+    ptr = child->body.meta; //start from meta,
+
     ret = ber_rebuild_integer(
             WANDDER_CLASS_CONTEXT_PRIMITIVE, 
             0, 
@@ -1131,7 +1463,6 @@ static void update_etsili_umtsiri(
     lookup = WANDDER_UMTSIRI_CONTENTS_ECGI;
     HASH_FIND(hh, params, &lookup, sizeof(lookup), p);
     if (p) {
-        rem -= ret;
         encode_here_ber_update(
                 10, WANDDER_CLASS_CONTEXT_PRIMITIVE, WANDDER_TAG_OCTETSTRING,
                 p->itemptr, p->itemlen,
@@ -1312,9 +1643,6 @@ static void update_etsili_umtsiri(
         fprintf(stderr, "wandder: UMTS IRI record may be invalid...\n");
     }
 
-    //ensure there is enough space for the last section
-    child->body.data = data_ptr_diff + child->buf;
-    ptr += check_body_size(child, (ptr - child->body.buf) + (8*2));
     ENDCONSTRUCTEDBLOCK(ptr,8) //endseq
     child->body.len = ptr - child->body.buf;
     child->len = ptr - child->buf;
@@ -1357,6 +1685,34 @@ void wandder_init_etsili_umtsiri(
 
 }
 
+//lays a child out using a definite length template instead
+static void init_definite_child(wandder_etsili_child_t * child,
+        wandder_definite_template_t *tmpl) {
+
+    if (tmpl->len > child->alloc_len) {
+        child->buf = realloc(child->buf, tmpl->len);
+        child->alloc_len = tmpl->len;
+    }
+    memcpy(child->buf, tmpl->buf, tmpl->len);
+    child->len = tmpl->len;
+
+    child->header.buf   = child->buf;
+    child->header.len   = tmpl->headerlen;
+    child->header.cin   = child->buf + tmpl->cin;
+    child->header.seqno = child->buf + tmpl->seqno;
+    child->header.sec   = child->buf + tmpl->sec;
+    child->header.usec  = child->buf + tmpl->usec;
+    child->header.end   = child->buf + tmpl->end;
+
+    child->body.buf         = child->buf + tmpl->headerlen;
+    child->body.len         = tmpl->len - tmpl->headerlen;
+    child->body.alloc_len   = child->alloc_len - tmpl->headerlen;
+    child->body.meta        = child->buf + tmpl->meta;
+    child->body.data        = child->buf + tmpl->data;
+    child->definite = tmpl;
+    __atomic_add_fetch(&(tmpl->refs), 1, __ATOMIC_RELAXED);
+}
+
 wandder_etsili_child_t *wandder_etsili_create_child(wandder_etsili_top_t* top, 
         wandder_generic_body_t * body) {
 
@@ -1382,11 +1738,11 @@ wandder_etsili_child_t *wandder_etsili_create_child(wandder_etsili_top_t* top,
 
     child->owner = top;
     child->flist = body->flist;
+    child->generation = 0;
     if (child->flist) {
-        if (pthread_mutex_lock(&(child->flist->mutex)) == 0) {
-            child->flist->counter++;
-        pthread_mutex_unlock(&(child->flist->mutex));
-        }
+        __atomic_add_fetch(&(child->flist->counter), 1, __ATOMIC_RELAXED);
+        child->generation = __atomic_load_n(&(child->flist->generation),
+                __ATOMIC_ACQUIRE);
     }
 
     child->header.buf = child->buf;
@@ -1402,8 +1758,7 @@ wandder_etsili_child_t *wandder_etsili_create_child(wandder_etsili_top_t* top,
     child->header.end   = diff + top->header.end;
 
 
-    //TODO potential to make header/body into one buffer 
-    ///as header size is const
+    //header and body share the one buffer, as the header size is const
     child->body.buf = child->header.buf + child->header.len; 
 
     child->body.alloc_len = body->len; 
@@ -1415,6 +1770,11 @@ wandder_etsili_child_t *wandder_etsili_create_child(wandder_etsili_top_t* top,
     diff = child->body.buf - body->buf;
     child->body.meta = diff + body->meta;
     child->body.data = diff + body->data;
+    child->definite = NULL;
+
+    if (body->definite) {
+        init_definite_child(child, body->definite);
+    }
 
     return child;
 
@@ -1422,34 +1782,47 @@ wandder_etsili_child_t *wandder_etsili_create_child(wandder_etsili_top_t* top,
 
 void wandder_free_child(wandder_etsili_child_t * child){
 
-    if (child) {
-        if (child->flist){
-            if (pthread_mutex_lock(&(child->flist->mutex)) == 0) {
-                if (child->flist->marked_for_delete == 0){
-                    //release and return
-                    child->nextfree = child->flist->first;
-                    child->flist->first = child;
-
-                    pthread_mutex_unlock(&(child->flist->mutex));
-                    return;
-                }
+    wandder_etsili_child_freelist_t *flist;
 
-                child->flist->counter--;
-                
-                if (child->flist->counter == 0){
-                    //we are the sole owner so we can free it
-                    pthread_mutex_destroy(&(child->flist->mutex));
-                    free(child->flist);
-                } else {
-                    pthread_mutex_unlock(&(child->flist->mutex));
+    if (child) {
+        flist = child->flist;
+        if (flist && __atomic_load_n(&(flist->marked_for_delete),
+                    __ATOMIC_SEQ_CST) == 0 &&
+                child->generation == __atomic_load_n(&(flist->generation),
+                    __ATOMIC_ACQUIRE)) {
+            if (__atomic_add_fetch(&(flist->freecount), 1,
+                        __ATOMIC_RELAXED) <= WANDDER_ETSILI_MAX_FREE_CHILDREN) {
+                /* Hold our own reference while pushing: once the child is
+                 * on the list, a concurrent drain may free it and drop its
+                 * reference, and we still need to look at the list after
+                 * that */
+                __atomic_add_fetch(&(flist->counter), 1, __ATOMIC_ACQ_REL);
+
+                //release and return
+                child->nextfree = __atomic_load_n(&(flist->first),
+                        __ATOMIC_RELAXED);
+                while (!__atomic_compare_exchange_n(&(flist->first),
+                            &(child->nextfree), child, 1,
+                            __ATOMIC_RELEASE, __ATOMIC_RELAXED));
+
+                /* If the freelist was deleted while we were pushing, our
+                 * child may have missed the drain so do it again */
+                if (__atomic_load_n(&(flist->marked_for_delete),
+                            __ATOMIC_SEQ_CST) != 0) {
+                    drain_child_freelist(flist);
                 }
+                release_child_freelist(flist);
+                return;
             }
+            /* Plenty of spare children already, free this one instead */
+            __atomic_sub_fetch(&(flist->freecount), 1, __ATOMIC_RELAXED);
         }
 
-        if (child->buf)
-            free(child->buf);
-        
-        free(child);
+        free_child_memory(child);
+
+        if (flist) {
+            release_child_freelist(flist);
+        }
     }
 }
 
@@ -1748,6 +2121,274 @@ void wandder_init_etsili_umtscc(
     return;
 }
 
+//writes a minimal definite length field for len (if out is not NULL) and
+//returns its size
+static size_t definite_length_octets(size_t len, uint8_t *out) {
+
+    size_t lenocts = 0, tmp = len, i;
+
+    if (len < 128) {
+        if (out) {
+            out[0] = (uint8_t)len;
+        }
+        return 1;
+    }
+
+    while (tmp) {
+        lenocts ++;
+        tmp >>= 8;
+    }
+
+    if (out) {
+        out[0] = 0x80 | lenocts;
+        for (i = 0; i < lenocts; i++) {
+            out[lenocts - i] = (len >> (8 * i)) & 0xff;
+        }
+    }
+    return lenocts + 1;
+}
+
+//reads the identifier and length of the template element at ptr. Returns
+//the number of identifier octets, or 0 if the element is malformed. Sets
+//vallen to -1 for indefinite length elements.
+static size_t read_template_element(uint8_t *ptr, uint8_t *end,
+        size_t *lenocts, int64_t *vallen) {
+
+    size_t idlen = 1;
+    size_t i;
+
+    if ((ptr[0] & 0x1f) == 0x1f) {
+        while (ptr + idlen < end && (ptr[idlen] & 0x80)) {
+            idlen ++;
+        }
+        idlen ++;
+    }
+    if (ptr + idlen >= end) {
+        return 0;
+    }
+
+    ptr += idlen;
+    if (ptr[0] == 0x80) {
+        *lenocts = 1;
+        *vallen = -1;
+    } else if (ptr[0] & 0x80) {
+        *lenocts = (ptr[0] & 0x7f) + 1;
+        if (*lenocts > 9 || ptr + *lenocts > end) {
+            return 0;
+        }
+        *vallen = 0;
+        for (i = 1; i < *lenocts; i++) {
+            *vallen = (*vallen << 8) | ptr[i];
+        }
+    } else {
+        *lenocts = 1;
+        *vallen = ptr[0];
+    }
+    return idlen;
+}
+
+#define MAX_TEMPLATE_CONSTRUCTS 64
+
+//rewrites an indefinite length template (header followed by the body up
+//to the data) using definite lengths. marks holds the offsets of cin,
+//seqno, sec, usec, end, meta and data in the input, in that order.
+static wandder_definite_template_t *build_definite_template(uint8_t *in,
+        size_t inlen, ptrdiff_t *marks) {
+
+    wandder_definite_template_t *tmpl = NULL;
+    ptrdiff_t *outmarks[7];
+    uint8_t markhit[7];
+    size_t stackcontent[WANDDER_ETSILI_MAX_DEFINITE_SLOTS];
+    int stackindex[WANDDER_ETSILI_MAX_DEFINITE_SLOTS];
+    size_t stackidlen[WANDDER_ETSILI_MAX_DEFINITE_SLOTS];
+    size_t closedlen[MAX_TEMPLATE_CONSTRUCTS];
+    int depth = 0, ncons = 0, k, m;
+    size_t p, o, idlen, lenocts, elemlen;
+    int64_t vallen;
+
+    /* First pass: work out the content length of every constructed
+     * element that is closed within the template */
+    p = 0;
+    while (p < inlen) {
+        if (depth > 0 && p + 1 < inlen && in[p] == 0 && in[p + 1] == 0) {
+            depth --;
+            closedlen[stackindex[depth]] = stackcontent[depth];
+            elemlen = stackidlen[depth] + stackcontent[depth] +
+                    definite_length_octets(stackcontent[depth], NULL);
+            if (depth > 0) {
+                stackcontent[depth - 1] += elemlen;
+            }
+            p += 2;
+            continue;
+        }
+
+        idlen = read_template_element(in + p, in + inlen, &lenocts, &vallen);
+        if (idlen == 0) {
+            fprintf(stderr, "wandder: malformed template at offset %zu\n", p);
+            return NULL;
+        }
+
+        if (vallen < 0) {
+            if (depth == WANDDER_ETSILI_MAX_DEFINITE_SLOTS ||
+                    ncons == MAX_TEMPLATE_CONSTRUCTS) {
+                fprintf(stderr, "wandder: template is too deeply nested\n");
+                return NULL;
+            }
+            stackcontent[depth] = 0;
+            stackindex[depth] = ncons;
+            stackidlen[depth] = idlen;
+            closedlen[ncons] = (size_t)-1;
+            ncons ++;
+            depth ++;
+            p += idlen + 1;
+            continue;
+        }
+
+        elemlen = idlen + lenocts + vallen;
+        if (p + elemlen > inlen) {
+            fprintf(stderr, "wandder: malformed template at offset %zu\n", p);
+            return NULL;
+        }
+        if (depth > 0) {
+            stackcontent[depth - 1] += elemlen;
+        }
+        p += elemlen;
+    }
+
+    /* Second pass: write it out. A definite length field is never more
+     * than 9 octets, so this is plenty. */
+    tmpl = calloc(1, sizeof(wandder_definite_template_t));
+    tmpl->buf = malloc(inlen + (ncons * 9));
+    tmpl->refs = 1;
+
+    outmarks[0] = &(tmpl->cin);
+    outmarks[1] = &(tmpl->seqno);
+    outmarks[2] = &(tmpl->sec);
+    outmarks[3] = &(tmpl->usec);
+    outmarks[4] = &(tmpl->end);
+    outmarks[5] = &(tmpl->meta);
+    outmarks[6] = &(tmpl->data);
+    memset(markhit, 0, sizeof(markhit));
+
+    p = 0;
+    o = 0;
+    k = 0;
+    depth = 0;
+    while (1) {
+        for (m = 0; m < 7; m++) {
+            if (marks[m] == (ptrdiff_t)p) {
+                *(outmarks[m]) = o;
+                markhit[m] = 1;
+            }
+        }
+        if (p >= inlen) {
+            break;
+        }
+
+        if (depth > 0 && p + 1 < inlen && in[p] == 0 && in[p + 1] == 0) {
+            depth --;
+            p += 2;
+            continue;
+        }
+
+        idlen = read_template_element(in + p, in + inlen, &lenocts, &vallen);
+        if (vallen < 0) {
+            memcpy(tmpl->buf + o, in + p, idlen);
+            o += idlen;
+            if (closedlen[k] != (size_t)-1) {
+                o += definite_length_octets(closedlen[k], tmpl->buf + o);
+            } else {
+                tmpl->slots[tmpl->slotcount] = o;
+                tmpl->slotcount ++;
+                memset(tmpl->buf + o, 0, WANDDER_ETSILI_DEFINITE_LENOCTS + 1);
+                tmpl->buf[o] = 0x80 | WANDDER_ETSILI_DEFINITE_LENOCTS;
+                o += WANDDER_ETSILI_DEFINITE_LENOCTS + 1;
+            }
+            k ++;
+            depth ++;
+            p += idlen + 1;
+            continue;
+        }
+
+        elemlen = idlen + lenocts + vallen;
+        memcpy(tmpl->buf + o, in + p, elemlen);
+        o += elemlen;
+        p += elemlen;
+    }
+
+    for (m = 0; m < 7; m++) {
+        if (!markhit[m]) {
+            fprintf(stderr,
+                    "wandder: template field does not start an element\n");
+            free(tmpl->buf);
+            free(tmpl);
+            return NULL;
+        }
+    }
+
+    tmpl->len = o;
+    tmpl->headerlen = tmpl->end;
+    return tmpl;
+}
+
+int wandder_init_etsili_definite_length(wandder_etsili_top_t* top,
+        wandder_generic_body_t * body) {
+
+    wandder_definite_template_t *tmpl;
+    ptrdiff_t marks[7];
+    size_t prefixlen;
+    uint8_t *in;
+
+    if (!top || !top->header.buf) {
+        fprintf(stderr,"Make sure wandder_encode_init_top_ber is called first\n");
+        return -1;
+    }
+    if (!body || !body->buf) {
+        fprintf(stderr,
+            "Make sure wandder_init_etsili_??? have been called first\n");
+        return -1;
+    }
+    if (body == &(top->ipiri) || body == &(top->umtsiri)) {
+        /* these are rebuilt from scratch for every record */
+        fprintf(stderr,
+                "wandder: definite lengths are only supported for CC and IPMMIRI records\n");
+        return -1;
+    }
+
+    prefixlen = body->data - body->buf;
+    in = malloc(top->header.len + prefixlen);
+    memcpy(in, top->header.buf, top->header.len);
+    memcpy(in + top->header.len, body->buf, prefixlen);
+
+    marks[0] = top->header.cin - top->header.buf;
+    marks[1] = top->header.seqno - top->header.buf;
+    marks[2] = top->header.sec - top->header.buf;
+    marks[3] = top->header.usec - top->header.buf;
+    marks[4] = top->header.end - top->header.buf;
+    marks[5] = top->header.len + (body->meta - body->buf);
+    marks[6] = top->header.len + prefixlen;
+
+    tmpl = build_definite_template(in, top->header.len + prefixlen, marks);
+    free(in);
+    if (tmpl == NULL) {
+        return -1;
+    }
+
+    release_definite_template(body->definite);
+    body->definite = tmpl;
+
+    /* Spare children were built for the old format, so get rid of them
+     * now. Children still in use see the new generation and free
+     * themselves when released; any that slip past while we are draining
+     * are caught when they are popped.
+     */
+    if (body->flist) {
+        __atomic_add_fetch(&(body->flist->generation), 1, __ATOMIC_ACQ_REL);
+        drain_child_freelist(body->flist);
+    }
+    return 0;
+}
+
 void wandder_encode_etsi_ipmmcc_ber (
         int64_t cin, int64_t seqno,
         struct timeval* tv, void* ipcontents, size_t iplen, uint8_t dir,
@@ -1763,6 +2404,11 @@ void wandder_encode_etsi_ipmmcc_ber (
         fprintf(stderr,"Call init ipmmcc first.\n");
         return;
     }
+    if (!cc_record_fits(child->definite, iplen)) {
+        /* Don't leave the previous record looking like the result */
+        child->len = 0;
+        return;
+    }
 
     update_etsili_pshdr_pc(&child->header, cin, seqno, tv);
     update_etsili_ipmmcc(ipcontents, iplen, dir, child);
@@ -1787,6 +2433,11 @@ void wandder_encode_etsi_ipmmiri_ber (
         fprintf(stderr,"Call init ipmmiri first.\n");
         return;
     }
+    if (!cc_record_fits(child->definite, iplen)) {
+        /* Don't leave the previous record looking like the result */
+        child->len = 0;
+        return;
+    }
 
     update_etsili_pshdr_pc(&child->header, cin, seqno, tv);
     update_etsili_ipmmiri(ipcontents, iplen, iritype, child);
@@ -1808,6 +2459,11 @@ void wandder_encode_etsi_ipcc_ber (
         fprintf(stderr,"Call init ipcc first.\n");
         return;
     }
+    if (!cc_record_fits(child->definite, iplen)) {
+        /* Don't leave the previous record looking like the result */
+        child->len = 0;
+        return;
+    }
     
     update_etsili_pshdr_pc(&child->header, cin, seqno, tv);
     update_etsili_ipcc(ipcontents, iplen, dir, child);
@@ -1870,12 +2526,169 @@ void wandder_encode_etsi_umtscc_ber (
         fprintf(stderr,"Call init umtscc first.\n");
         return;
     }
+    if (!cc_record_fits(child->definite, iplen)) {
+        /* Don't leave the previous record looking like the result */
+        child->len = 0;
+        return;
+    }
     
     update_etsili_pshdr_pc(&child->header, cin, seqno, tv);
     update_etsili_umtscc(ipcontents, iplen, dir, child);
 
 }
 
+int wandder_encode_etsi_ipcc_iov(
+        int64_t cin, int64_t seqno,
+        struct timeval* tv, void* ipcontents, size_t iplen, uint8_t dir,
+        wandder_etsili_child_t * child, struct iovec *iov) {
+
+    if (!child || !child->header.buf) {
+        //error out for not initlizing top first
+        fprintf(stderr,"Make sure wandder_encode_init_top_ber is called first\n");
+        return -1;
+    }
+    if (!child->body.buf) {
+        //error out for not initlizing ipcc
+        fprintf(stderr,"Call init ipcc first.\n");
+        return -1;
+    }
+    if (!cc_record_fits(child->definite, iplen)) {
+        return -1;
+    }
+
+    update_etsili_pshdr_pc(&child->header, cin, seqno, tv);
+    update_cc_direction(dir, child->body.meta, child->owner);
+    return update_etsili_cc_iov(ipcontents, iplen, 0, 7, child, iov);
+}
+
+int wandder_encode_etsi_umtscc_iov(
+        int64_t cin, int64_t seqno,
+        struct timeval* tv, void* ipcontents, size_t iplen, uint8_t dir,
+        wandder_etsili_child_t * child, struct iovec *iov) {
+
+    if (!child || !child->header.buf) {
+        //error out for not initlizing top first
+        fprintf(stderr,"Make sure wandder_encode_init_top_ber is called first\n");
+        return -1;
+    }
+    if (!child->body.buf) {
+        //error out for not initlizing umtscc
+        fprintf(stderr,"Call init umtscc first.\n");
+        return -1;
+    }
+    if (!cc_record_fits(child->definite, iplen)) {
+        return -1;
+    }
+
+    update_etsili_pshdr_pc(&child->header, cin, seqno, tv);
+    update_cc_direction(dir, child->body.meta, child->owner);
+    return update_etsili_cc_iov(ipcontents, iplen, 4, 5, child, iov);
+}
+
+int wandder_encode_etsi_ipcc_batch_ber(wandder_etsili_top_t *top,
+        wandder_etsili_ipcc_record_t *records, int count,
+        uint8_t *outbuf, size_t outlen) {
+
+    wandder_pshdr_t hdr;
+    wandder_definite_template_t *tmpl;
+    etsili_pshdr_diff_t hdrdiff;
+    ptrdiff_t metadiff;
+    size_t off = 0, need, prefixlen, firstlen;
+    uint8_t *ptr, *first, *second;
+    int i;
+
+    if (!top || !top->header.buf) {
+        //error out for not initlizing top first
+        fprintf(stderr,"Make sure wandder_encode_init_top_ber is called first\n");
+        return -1;
+    }
+    if (!top->ipcc.buf) {
+        //error out for not initlizing ipcc
+        fprintf(stderr,"Call init ipcc first.\n");
+        return -1;
+    }
+
+    /* Work out where the variable fields are in the templates once, rather
+     * than once per record. Offsets are from the start of the record. */
+    tmpl = top->ipcc.definite;
+    if (tmpl) {
+        first               = tmpl->buf;
+        firstlen            = tmpl->len;
+        second              = NULL;
+        prefixlen           = tmpl->len;
+        hdrdiff.cin_diff    = tmpl->cin;
+        hdrdiff.seqno_diff  = tmpl->seqno;
+        hdrdiff.sec_diff    = tmpl->sec;
+        hdrdiff.usec_diff   = tmpl->usec;
+        hdrdiff.end_diff    = tmpl->end;
+        metadiff            = tmpl->meta;
+    } else {
+        first               = top->header.buf;
+        firstlen            = top->header.len;
+        second              = top->ipcc.buf;
+        prefixlen           = top->header.len +
+                (top->ipcc.data - top->ipcc.buf);
+        hdrdiff.cin_diff    = top->header.cin - top->header.buf;
+        hdrdiff.seqno_diff  = top->header.seqno - top->header.buf;
+        hdrdiff.sec_diff    = top->header.sec - top->header.buf;
+        hdrdiff.usec_diff   = top->header.usec - top->header.buf;
+        hdrdiff.end_diff    = top->header.end - top->header.buf;
+        metadiff            = top->header.len +
+                (top->ipcc.meta - top->ipcc.buf);
+    }
+
+    for (i = 0; i < count; i++) {
+        wandder_etsili_ipcc_record_t *rec = &(records[i]);
+
+        if (!cc_record_fits(tmpl, rec->iplen)) {
+            break;
+        }
+        need = prefixlen + calculate_length(0,
+                WANDDER_CLASS_CONTEXT_PRIMITIVE, WANDDER_TAG_IPPACKET,
+                rec->iplen);
+        if (!tmpl) {
+            /* End-of-contents octets for the indefinite length form */
+            need += (7*2);
+        }
+        if (need > outlen - off) {
+            break;
+        }
+
+        ptr = outbuf + off;
+        memcpy(ptr, first, firstlen);
+        if (second) {
+            memcpy(ptr + firstlen, second, prefixlen - firstlen);
+        }
+
+        hdr.buf     = ptr;
+        hdr.len     = hdrdiff.end_diff;
+        hdr.cin     = ptr + hdrdiff.cin_diff;
+        hdr.seqno   = ptr + hdrdiff.seqno_diff;
+        hdr.sec     = ptr + hdrdiff.sec_diff;
+        hdr.usec    = ptr + hdrdiff.usec_diff;
+        hdr.end     = ptr + hdrdiff.end_diff;
+        update_etsili_pshdr_pc(&hdr, rec->cin, rec->seqno, &(rec->tv));
+        update_cc_direction(rec->dir, ptr + metadiff, top);
+
+        ptr += prefixlen;
+        ptr += encode_here_ber(0, WANDDER_CLASS_CONTEXT_PRIMITIVE,
+                WANDDER_TAG_IPPACKET, rec->ipcontents, rec->iplen, ptr,
+                outlen - (ptr - outbuf));
+        if (tmpl) {
+            patch_definite_lengths(tmpl, outbuf + off,
+                    ptr - (outbuf + off));
+        } else {
+            ENDCONSTRUCTEDBLOCK(ptr,7)
+        }
+
+        rec->offset = off;
+        rec->len = ptr - (outbuf + off);
+        off += rec->len;
+    }
+
+    return i;
+}
+
 wandder_etsili_top_t* wandder_encode_init_top_ber (wandder_encoder_ber_t* enc_ber, 
         wandder_etsili_intercept_details_t* intdetails) {
 
@@ -1893,19 +2706,65 @@ wandder_etsili_top_t* wandder_encode_init_top_ber (wandder_encoder_ber_t* enc_be
 wandder_etsili_child_freelist_t *wandder_create_etsili_child_freelist() {
     wandder_etsili_child_freelist_t *flist;
 
-    pthread_mutexattr_t attr;
-
     flist = (wandder_etsili_child_freelist_t *)calloc(1,
             sizeof(wandder_etsili_child_freelist_t));
 
-    //setting recursive as lock operations happen across a linked list
-    pthread_mutexattr_init(&attr);
-    pthread_mutexattr_settype(&attr, PTHREAD_MUTEX_RECURSIVE);
-    pthread_mutex_init(&(flist->mutex), &attr);
     flist->first = NULL;
+    flist->popping = 0;
+    flist->freecount = 0;
+    /* The reference held by the body that this freelist is attached to */
+    flist->counter = 1;
+    flist->marked_for_delete = 0;
+    flist->generation = 0;
     return flist;
 }
 
+/* How many times to check the pop flag before giving up on the freelist */
+#define CHILD_POP_ATTEMPTS 1000
+
+static wandder_etsili_child_t *pop_free_child(
+        wandder_etsili_child_freelist_t *flist) {
+
+    wandder_etsili_child_t *head, *next;
+    int attempts = 0;
+
+    if (__atomic_load_n(&(flist->first), __ATOMIC_RELAXED) == NULL) {
+        return NULL;
+    }
+
+    /* Pushes can run concurrently with a pop, but two concurrent pops
+     * could suffer from ABA so only allow one at a time. A pop only takes
+     * a handful of instructions, so retry briefly -- but if the other
+     * popper looks to have been preempted, give up and let the caller
+     * create a fresh child instead of waiting on it.
+     */
+    while (__atomic_exchange_n(&(flist->popping), 1, __ATOMIC_ACQUIRE)) {
+        if (++attempts >= CHILD_POP_ATTEMPTS) {
+            return NULL;
+        }
+        while (__atomic_load_n(&(flist->popping), __ATOMIC_RELAXED)) {
+            if (++attempts >= CHILD_POP_ATTEMPTS) {
+                return NULL;
+            }
+        }
+    }
+
+    head = __atomic_load_n(&(flist->first), __ATOMIC_ACQUIRE);
+    while (head) {
+        next = head->nextfree;
+        if (__atomic_compare_exchange_n(&(flist->first), &head, next, 1,
+                    __ATOMIC_ACQUIRE, __ATOMIC_ACQUIRE)) {
+            break;
+        }
+    }
+
+    __atomic_store_n(&(flist->popping), 0, __ATOMIC_RELEASE);
+    if (head) {
+        __atomic_sub_fetch(&(flist->freecount), 1, __ATOMIC_RELAXED);
+    }
+    return head;
+}
+
 wandder_etsili_child_t *wandder_create_etsili_child(
         wandder_etsili_top_t* top, 
         wandder_generic_body_t * body) {
@@ -1913,15 +2772,14 @@ wandder_etsili_child_t *wandder_create_etsili_child(
     wandder_etsili_child_t *child = NULL;
 
     //only need to actually create child if none exist here
-
-    if (pthread_mutex_trylock(&(body->flist->mutex)) == 0) {
-        //if you cant obtain mutex just make a new child, no need to wait
-        if (body->flist->first) {
-            child = body->flist->first;
-            body->flist->first = child->nextfree;
+    if (body->flist) {
+        child = pop_free_child(body->flist);
+        if (child && child->definite != body->definite) {
+            /* Built before the body switched length formats */
+            free_child_memory(child);
+            release_child_freelist(body->flist);
+            child = NULL;
         }
-
-        pthread_mutex_unlock(&(body->flist->mutex));
     }
 
     if (child == NULL) {
@@ -29,18 +29,71 @@
 
 #include <libwandder.h>
 #include <stdint.h>
+#include <sys/uio.h>
 #include <uthash.h>
 #include "libwandder_etsili.h"
 
 typedef struct wandder_etsili_child wandder_etsili_child_t;
 
+/* Free children are kept on a lock-free stack. Any thread may push a
+ * child onto the stack, but only one thread at a time may pop, which is
+ * enough to prevent the ABA problem. A thread that finds 'popping' held
+ * for more than a brief moment does not wait; it creates a new child
+ * instead. Because of that, the number of children kept on the stack is
+ * capped at WANDDER_ETSILI_MAX_FREE_CHILDREN ('freecount') and any extras
+ * are freed when they are released.
+ *
+ * 'counter' is the number of children that refer to this freelist, plus
+ * one for the body that owns it. Whoever drops it to zero frees the list.
+ *
+ * 'generation' is bumped whenever the owning body switches length
+ * formats. Children built for an earlier generation are freed when they
+ * are released rather than going back on the stack.
+ */
+#define WANDDER_ETSILI_MAX_FREE_CHILDREN 1024
+
 typedef struct wandder_etsili_child_freelist {
-    pthread_mutex_t mutex;
     wandder_etsili_child_t * first;
+    uint8_t popping;
+    int freecount;
     int counter;
     int marked_for_delete;
+    uint32_t generation;
 } wandder_etsili_child_freelist_t;
 
+/* Largest number of open constructed elements that can enclose the data
+ * in a definite length template */
+#define WANDDER_ETSILI_MAX_DEFINITE_SLOTS 16
+
+/* Number of octets in the long-form length field written for each of
+ * those elements, so records can be up to 16MB */
+#define WANDDER_ETSILI_DEFINITE_LENOCTS 3
+
+/* A header and body template rewritten to use definite lengths. Elements
+ * that are complete within the template get their real length; the ones
+ * that enclose the data are given a fixed width length field ('slots',
+ * outermost first) that is patched as each record is encoded. All
+ * positions are offsets from the start of buf.
+ *
+ * 'refs' counts the body using the template plus every child created from
+ * it, so children still in use keep the template alive if it is replaced.
+ */
+typedef struct wandder_definite_template {
+    uint8_t *buf;
+    size_t len;
+    size_t headerlen;
+    ptrdiff_t cin;
+    ptrdiff_t seqno;
+    ptrdiff_t sec;
+    ptrdiff_t usec;
+    ptrdiff_t end;
+    ptrdiff_t meta;
+    ptrdiff_t data;
+    uint8_t slotcount;
+    ptrdiff_t slots[WANDDER_ETSILI_MAX_DEFINITE_SLOTS];
+    int refs;
+} wandder_definite_template_t;
+
 typedef struct wandder_generic_body {
     uint8_t* buf;
     size_t len;
@@ -48,6 +101,7 @@ typedef struct wandder_generic_body {
     uint8_t* meta;
     uint8_t* data;
     wandder_etsili_child_freelist_t * flist;
+    wandder_definite_template_t * definite;
 } wandder_generic_body_t;
 
 typedef struct wandder_etsili_top {
@@ -72,6 +126,8 @@ struct wandder_etsili_child {
 
     wandder_etsili_child_freelist_t * flist;
     wandder_etsili_child_t * nextfree;
+    wandder_definite_template_t * definite;
+    uint32_t generation;
 };
 
 wandder_etsili_top_t* wandder_encode_init_top_ber (
@@ -110,6 +166,55 @@ void wandder_encode_etsi_umtscc_ber (
         struct timeval* tv, void* ipcontents, size_t iplen, uint8_t dir,
         wandder_etsili_child_t * child);
 
+/* A single IPCC record to be encoded as part of a batch */
+typedef struct wandder_etsili_ipcc_record {
+    /* Input */
+    int64_t cin;
+    int64_t seqno;
+    struct timeval tv;
+    void *ipcontents;
+    size_t iplen;
+    uint8_t dir;
+
+    /* Output -- where the encoded record was written in the batch buffer */
+    size_t offset;
+    size_t len;
+} wandder_etsili_ipcc_record_t;
+
+/* Encodes up to 'count' IPCC records back to back into 'outbuf', filling
+ * in the offset and length of each one. No child is required; the
+ * records are built directly from the templates in 'top'.
+ *
+ * Returns the number of records encoded, which will be less than 'count'
+ * if 'outbuf' ran out of space, or -1 on error.
+ */
+int wandder_encode_etsi_ipcc_batch_ber(wandder_etsili_top_t *top,
+        wandder_etsili_ipcc_record_t *records, int count,
+        uint8_t *outbuf, size_t outlen);
+
+/* Number of iovecs filled in by the wandder_encode_etsi_*_iov functions */
+#define WANDDER_ETSILI_CC_IOV_COUNT 3
+
+/* Scatter-gather versions of the IPCC and UMTSCC encoders. Rather than
+ * copying the packet into the child buffer, these describe the record as
+ * WANDDER_ETSILI_CC_IOV_COUNT iovecs: the encoded header and preamble
+ * (in the child buffer), the caller's packet and the trailing
+ * end-of-contents octets (also in the child buffer). The result can be
+ * passed straight to writev() or sendmsg().
+ *
+ * The packet must remain valid, and the child must not be reused, until
+ * the iovecs have been consumed. Returns the number of iovecs filled in,
+ * or -1 on error.
+ */
+int wandder_encode_etsi_ipcc_iov(
+        int64_t cin, int64_t seqno,
+        struct timeval *tv, void *ipcontents, size_t iplen, uint8_t dir,
+        wandder_etsili_child_t * child, struct iovec *iov);
+int wandder_encode_etsi_umtscc_iov(
+        int64_t cin, int64_t seqno,
+        struct timeval* tv, void* ipcontents, size_t iplen, uint8_t dir,
+        wandder_etsili_child_t * child, struct iovec *iov);
+
 void wandder_init_etsili_ipcc(
         wandder_encoder_ber_t* enc_ber,
         wandder_etsili_top_t* top);
@@ -129,6 +234,18 @@ void wandder_init_etsili_umtsiri(
         wandder_encoder_ber_t* enc_ber,
         wandder_etsili_top_t* top);
 
+/* Switches an initialised IPCC, UMTSCC, IPMMCC or IPMMIRI body over to
+ * definite length encoding, so records no longer need end-of-contents
+ * markers and their length can be read from the first few octets.
+ * Spare children on the body's freelist are discarded; children that are
+ * in use keep their old format and are freed, rather than reused, once
+ * they are released.
+ *
+ * Returns 0 on success, -1 if the body cannot use definite lengths.
+ */
+int wandder_init_etsili_definite_length(wandder_etsili_top_t* top,
+        wandder_generic_body_t * body);
+
 wandder_etsili_child_freelist_t *wandder_create_etsili_child_freelist();
 wandder_etsili_child_t *wandder_create_etsili_child(wandder_etsili_top_t* top, 
         wandder_generic_body_t * body);
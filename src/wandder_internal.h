@@ -30,6 +30,10 @@
 #include <stddef.h>
 #include "libwandder.h"
 
+/* Longest possible output from encode_time_inline(), i.e. a
+ * GeneralizedTime of the form YYYYmmddHHMMSS.mmmZ
+ */
+#define MAX_ENCODED_TIME_LEN 19
 
 size_t ber_rebuild_integer(uint8_t itemclass, uint32_t idnum, void *valptr, 
         size_t vallen, void* buf);
@@ -40,6 +44,9 @@ size_t calculate_length(uint8_t idnum, uint8_t class, uint8_t encodeas,
 size_t encode_here_ber(uint8_t idnum, uint8_t class, uint8_t encodeas, 
         uint8_t* valptr, size_t vallen, uint8_t* ptr, ptrdiff_t rem);
 
+size_t encode_preamble_here_ber(uint8_t idnum, uint8_t class,
+        size_t vallen, uint8_t* ptr, ptrdiff_t rem);
+
 typedef struct etsili_pshdr_diff {
     ptrdiff_t cin_diff;
     ptrdiff_t seqno_diff;